@@ -0,0 +1,451 @@
+// Copyright Offworld Industries
+
+#include "OWI_BenchmarkCommandlet.h"
+#include "Engine/EngineTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OWI_CircularDependencyDetector.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "OWI_ReferenceRulesMatcher.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY(LogOWIBenchmarkCommandlet);
+
+namespace OWIBenchmarkCommandlet
+{
+	// Same seed for every run so results stay comparable
+	constexpr int32 RandomSeed = 1337;
+
+	constexpr int32 NumRandomDependencies = 2;
+
+	/**
+	 * Forwards everything to the real allocator and counts the allocations while enabled.
+	 * It stays installed for the rest of the process, so every virtual has to reach the real allocator, e.g. Trim
+	 * on garbage collection and the TLS cache setup of new threads.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+
+	public:
+
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void InitializeStatsMetadata() override
+		{
+			InnerMalloc->InitializeStatsMetadata();
+		}
+
+		virtual void UpdateStats() override
+		{
+			InnerMalloc->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+		{
+			InnerMalloc->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+		{
+			InnerMalloc->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return InnerMalloc->ValidateHeap();
+		}
+
+		virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+		{
+			return InnerMalloc->Exec(InWorld, Cmd, Ar);
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return InnerMalloc->GetDescriptiveName();
+		}
+
+		TAtomic<int64> NumAllocations { 0 };
+
+		TAtomic<bool> bEnabled { false };
+
+	private:
+
+		FMalloc* InnerMalloc;
+
+		void CountAllocation()
+		{
+			if (bEnabled.Load(EMemoryOrder::Relaxed))
+			{
+				++NumAllocations;
+			}
+		}
+	};
+
+	/**
+	 * \brief Install the counting allocator the first time it is needed, it stays installed until the process exits
+	 * \return The counting allocator
+	 */
+	FCountingMalloc& GetCountingMalloc()
+	{
+		// Never destroyed, memory allocated through it may still be freed after the commandlet is done
+		static FCountingMalloc* CountingMalloc = nullptr;
+		if (CountingMalloc == nullptr)
+		{
+			CountingMalloc = new FCountingMalloc(GMalloc);
+			GMalloc = CountingMalloc;
+		}
+		return *CountingMalloc;
+	}
+
+	FString GetFolderPath(const int32 FolderIndex)
+	{
+		return FString::Printf(TEXT("/Game/Benchmark/Folder%d"), FolderIndex);
+	}
+
+	FString GetSubFolderPath(const int32 FolderIndex, const int32 SubFolderIndex)
+	{
+		return FString::Printf(TEXT("/Game/Benchmark/Folder%d/Sub%d"), FolderIndex, SubFolderIndex);
+	}
+}
+
+UOWIBenchmarkCommandlet::UOWIBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Times the reference rules, circular dependency and naming convention checks on synthetic data");
+	HelpUsage = TEXT("-run=OWIBenchmark [-Nodes=10000+100000+1000000] [-Rules=32] [-Exceptions=4] [-CycleEvery=1000] [-Json=Path]");
+}
+
+int32 UOWIBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	TArray<int32> NodeCounts;
+	if (const FString* NodesParam = ParamsMap.Find(TEXT("Nodes")))
+	{
+		TArray<FString> NodeCountStrings;
+		NodesParam->ParseIntoArray(NodeCountStrings, TEXT("+"));
+		for (const FString& NodeCountString : NodeCountStrings)
+		{
+			NodeCounts.Add(FCString::Atoi(*NodeCountString));
+		}
+	}
+	if (NodeCounts.Num() == 0)
+	{
+		NodeCounts = { 10000, 100000, 1000000 };
+	}
+
+	const int32 NumRules = ParamsMap.Contains(TEXT("Rules")) ? FCString::Atoi(*ParamsMap[TEXT("Rules")]) : 32;
+	const int32 NumExceptions = ParamsMap.Contains(TEXT("Exceptions")) ? FCString::Atoi(*ParamsMap[TEXT("Exceptions")]) : 4;
+	const int32 CycleEvery = ParamsMap.Contains(TEXT("CycleEvery")) ? FCString::Atoi(*ParamsMap[TEXT("CycleEvery")]) : 1000;
+	const FString JsonPath = ParamsMap.FindRef(TEXT("Json"));
+
+	TArray<FOWIReferenceRule> Rules;
+	TArray<FDirectoryPath> BlackList;
+	BuildRules(NumRules, NumExceptions, Rules, BlackList);
+
+	FOWIReferenceRulesMatcher Matcher;
+	Matcher.Compile(Rules, BlackList);
+
+	// The naming conventions run on the class default objects, they cover every loaded class without creating objects
+	TArray<UObject*> DefaultObjects;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (UObject* DefaultObject = It->GetDefaultObject(false))
+		{
+			DefaultObjects.Add(DefaultObject);
+		}
+	}
+	UOWINamingConventionHandler* NamingConventionHandler = NewObject<UOWINamingConventionHandler>(this);
+
+	TArray<FOWIBenchmarkResult> Results;
+	for (const int32 NumNodes : NodeCounts)
+	{
+		if (NumNodes <= 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogOWIBenchmarkCommandlet, Display, TEXT("Building graph with %d nodes"), NumNodes);
+		FOWIBenchmarkGraph Graph;
+		BuildGraph(NumNodes, NumRules + 1, CycleEvery, Graph);
+
+		// Both rule benchmarks count one operation per package checked against every rule, and like the handler they
+		// don't stop at the first violation
+		Results.Add(Measure(TEXT("ReferenceRule::IsViolated"), NumNodes, [&Graph, &Rules]()
+		{
+			FString ValidationError;
+			for (int32 NodeIndex = 0; NodeIndex < Graph.PackageNames.Num(); ++NodeIndex)
+			{
+				ValidationError.Reset();
+				for (const FOWIReferenceRule& Rule : Rules)
+				{
+					if (Rule.CanBeApplied(Graph.PackagePaths[NodeIndex]))
+					{
+						Rule.IsViolated(Graph.PackagePaths[NodeIndex], Graph.Dependencies[NodeIndex], ValidationError);
+					}
+				}
+			}
+			return static_cast<int64>(Graph.PackageNames.Num());
+		}));
+
+		Results.Add(Measure(TEXT("CompiledRules::FindViolatedRule"), NumNodes, [&Graph, &Matcher]()
+		{
+			FOWIReferenceRulesAssetContext AssetContext;
+			for (int32 NodeIndex = 0; NodeIndex < Graph.PackageNames.Num(); ++NodeIndex)
+			{
+				Matcher.ClassifyAsset(Graph.PackagePaths[NodeIndex], AssetContext);
+				for (const FName& Reference : Graph.Dependencies[NodeIndex])
+				{
+					Matcher.FindViolatedRule(AssetContext, Reference);
+				}
+			}
+			return static_cast<int64>(Graph.PackageNames.Num());
+		}));
+
+		Results.Add(Measure(TEXT("IsBlackListed"), NumNodes, [&Graph, &Matcher]()
+		{
+			FOWIReferenceRulesAssetContext AssetContext;
+			for (int32 NodeIndex = 0; NodeIndex < Graph.PackageNames.Num(); ++NodeIndex)
+			{
+				Matcher.ClassifyAsset(Graph.PackagePaths[NodeIndex], AssetContext);
+				for (const FName& Reference : Graph.Dependencies[NodeIndex])
+				{
+					if (Matcher.FindBlackListEntry(AssetContext, Reference) != INDEX_NONE)
+					{
+						break;
+					}
+				}
+			}
+			return static_cast<int64>(Graph.PackageNames.Num());
+		}));
+
+		Results.Add(Measure(TEXT("HasCircularDependency"), NumNodes, [&Graph]()
+		{
+			TMap<FName, int32> NodeIndices;
+			NodeIndices.Reserve(Graph.PackageNames.Num());
+			for (int32 NodeIndex = 0; NodeIndex < Graph.PackageNames.Num(); ++NodeIndex)
+			{
+				NodeIndices.Add(Graph.PackageNames[NodeIndex], NodeIndex);
+			}
+
+			// Same provider shape as the handler uses for the Asset Registry
+			FOWICircularDependencyDetector Detector;
+			TArray<FName> CyclePath;
+			for (const FName& PackageName : Graph.PackageNames)
+			{
+				Detector.FindCycle(PackageName, [&Graph, &NodeIndices](const FName DependencyPackageName, TArray<FName>& OutDependencies)
+				{
+					OutDependencies.Append(Graph.Dependencies[NodeIndices.FindChecked(DependencyPackageName)]);
+				}, CyclePath);
+			}
+			return static_cast<int64>(Graph.PackageNames.Num());
+		}));
+
+		Results.Add(Measure(TEXT("GetUObjectPrefixSuffix"), NumNodes, [NumNodes, &DefaultObjects, NamingConventionHandler]()
+		{
+			FString NewName;
+			for (int32 ObjectIndex = 0; ObjectIndex < NumNodes && DefaultObjects.Num() > 0; ++ObjectIndex)
+			{
+				NamingConventionHandler->GetConventionalName(DefaultObjects[ObjectIndex % DefaultObjects.Num()], NewName);
+			}
+			return static_cast<int64>(NumNodes);
+		}));
+	}
+
+	for (const FOWIBenchmarkResult& Result : Results)
+	{
+		const double OperationsPerSecond = Result.Seconds > 0.0 ? Result.Operations / Result.Seconds : 0.0;
+		const double AllocationsPerOperation = Result.Operations > 0 ? static_cast<double>(Result.Allocations) / Result.Operations : 0.0;
+		UE_LOG(LogOWIBenchmarkCommandlet, Display, TEXT("%-32s %8d nodes: %12.0f ops/s, %8.3f allocations/op, %.3f seconds"),
+			*Result.Name, Result.NumNodes, OperationsPerSecond, AllocationsPerOperation, Result.Seconds);
+	}
+
+	if (JsonPath.IsEmpty() == false && WriteJson(JsonPath, Results) == false)
+	{
+		UE_LOG(LogOWIBenchmarkCommandlet, Error, TEXT("Could not write JSON results: %s!"), *JsonPath);
+		return 1;
+	}
+
+	return 0;
+}
+
+void UOWIBenchmarkCommandlet::BuildGraph(const int32 NumNodes, const int32 NumFolders, const int32 CycleEvery, FOWIBenchmarkGraph& OutGraph)
+{
+	FRandomStream RandomStream(OWIBenchmarkCommandlet::RandomSeed);
+
+	OutGraph.PackageNames.Reset(NumNodes);
+	OutGraph.PackagePaths.Reset(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		const int32 FolderIndex = RandomStream.RandHelper(NumFolders);
+		const int32 SubFolderIndex = RandomStream.RandHelper(8);
+		FString PackagePath = FString::Printf(TEXT("%s/Asset%d"), *OWIBenchmarkCommandlet::GetSubFolderPath(FolderIndex, SubFolderIndex), NodeIndex);
+		OutGraph.PackageNames.Add(FName(*PackagePath));
+		OutGraph.PackagePaths.Add(MoveTemp(PackagePath));
+	}
+
+	// Every fourth package starts a diamond: A -> B, A -> C, B -> D, C -> D, all others form chains
+	OutGraph.Dependencies.SetNum(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex + 1 < NumNodes; ++NodeIndex)
+	{
+		TArray<FName>& Dependencies = OutGraph.Dependencies[NodeIndex];
+		if (NodeIndex % 4 == 0 && NodeIndex + 2 < NumNodes)
+		{
+			Dependencies.Add(OutGraph.PackageNames[NodeIndex + 1]);
+			Dependencies.Add(OutGraph.PackageNames[NodeIndex + 2]);
+		} else if (NodeIndex % 4 == 1 && NodeIndex + 2 < NumNodes)
+		{
+			Dependencies.Add(OutGraph.PackageNames[NodeIndex + 2]);
+		} else
+		{
+			Dependencies.Add(OutGraph.PackageNames[NodeIndex + 1]);
+		}
+
+		// Only forward dependencies, so the graph stays acyclic until cycles are added on purpose
+		for (int32 DependencyIndex = 0; DependencyIndex < OWIBenchmarkCommandlet::NumRandomDependencies; ++DependencyIndex)
+		{
+			Dependencies.AddUnique(OutGraph.PackageNames[RandomStream.RandRange(NodeIndex + 1, NumNodes - 1)]);
+		}
+
+		if (CycleEvery > 0 && NodeIndex > 0 && NodeIndex % CycleEvery == 0)
+		{
+			Dependencies.Add(OutGraph.PackageNames[RandomStream.RandRange(FMath::Max(0, NodeIndex - CycleEvery), NodeIndex - 1)]);
+		}
+	}
+}
+
+void UOWIBenchmarkCommandlet::BuildRules(const int32 NumRules, const int32 NumExceptions, TArray<FOWIReferenceRule>& OutRules, TArray<FDirectoryPath>& OutBlackList)
+{
+	OutRules.Reset(NumRules);
+	OutBlackList.Reset(NumRules);
+	for (int32 RuleIndex = 0; RuleIndex < NumRules; ++RuleIndex)
+	{
+		FOWIReferenceRule& Rule = OutRules.AddDefaulted_GetRef();
+		Rule.AssetFolder.Path = OWIBenchmarkCommandlet::GetFolderPath(RuleIndex);
+		Rule.MayNotReferenceFolder.Path = OWIBenchmarkCommandlet::GetFolderPath(RuleIndex + 1);
+		for (int32 ExceptionIndex = 0; ExceptionIndex < NumExceptions; ++ExceptionIndex)
+		{
+			Rule.ExceptionFolders.Add({ OWIBenchmarkCommandlet::GetSubFolderPath(RuleIndex + 1, ExceptionIndex) });
+		}
+
+		// Folders that don't exist in the graph, so the BlackList is walked completely for every reference
+		OutBlackList.Add({ FString::Printf(TEXT("/Game/Benchmark/BlackList%d"), RuleIndex) });
+	}
+}
+
+FOWIBenchmarkResult UOWIBenchmarkCommandlet::Measure(const FString& Name, const int32 NumNodes, const TFunctionRef<int64()> Benchmark)
+{
+	FOWIBenchmarkResult Result;
+	Result.Name = Name;
+	Result.NumNodes = NumNodes;
+
+	// Allocations of other threads are counted as well, a commandlet doesn't have many of those
+	OWIBenchmarkCommandlet::FCountingMalloc& CountingMalloc = OWIBenchmarkCommandlet::GetCountingMalloc();
+	CountingMalloc.NumAllocations = 0;
+	CountingMalloc.bEnabled = true;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Result.Operations = Benchmark();
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	CountingMalloc.bEnabled = false;
+	Result.Allocations = CountingMalloc.NumAllocations.Load();
+
+	return Result;
+}
+
+bool UOWIBenchmarkCommandlet::WriteJson(const FString& FilePath, const TArray<FOWIBenchmarkResult>& Results)
+{
+	FString Output;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Output);
+
+	Writer->WriteArrayStart();
+	for (const FOWIBenchmarkResult& Result : Results)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Result.Name);
+		Writer->WriteValue(TEXT("nodes"), Result.NumNodes);
+		Writer->WriteValue(TEXT("operations"), Result.Operations);
+		Writer->WriteValue(TEXT("seconds"), Result.Seconds);
+		Writer->WriteValue(TEXT("allocations"), Result.Allocations);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Output, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
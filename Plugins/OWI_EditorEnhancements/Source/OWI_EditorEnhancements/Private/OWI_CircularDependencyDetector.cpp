@@ -0,0 +1,85 @@
+// Copyright Offworld Industries
+
+#include "OWI_CircularDependencyDetector.h"
+
+void FOWICircularDependencyDetector::Reset()
+{
+	Components.Reset();
+	ComponentSizes.Reset();
+}
+
+bool FOWICircularDependencyDetector::FindCycle(const FName PackageName, const FGetDependencies GetDependencies, TArray<FName>& OutCyclePath)
+{
+	OutCyclePath.Reset();
+
+	const int32 Node = Components.FindOrAddNode(PackageName);
+	Components.Explore(Node, GetDependencies, [](const int32 VisitedNode)
+	{
+	}, [this](const int32 Component, const TArray<int32>& Members)
+	{
+		ComponentSizes.Add(Members.Num());
+	});
+
+	// Self references are ignored, so only components with more than one package are cycles
+	if (ComponentSizes[Components.GetComponent(Node)] < 2)
+	{
+		return false;
+	}
+
+	BuildCyclePath(Node, OutCyclePath);
+	return true;
+}
+
+int32 FOWICircularDependencyDetector::Num() const
+{
+	return Components.Num();
+}
+
+void FOWICircularDependencyDetector::BuildCyclePath(const int32 StartNode, TArray<FName>& OutCyclePath) const
+{
+	const int32 Component = Components.GetComponent(StartNode);
+
+	// Breadth first search within the component back to the start node
+	TMap<int32, int32> Predecessors;
+	TArray<int32> Queue;
+	Queue.Add(StartNode);
+
+	int32 LastNode = INDEX_NONE;
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num() && LastNode == INDEX_NONE; ++QueueIndex)
+	{
+		const int32 Node = Queue[QueueIndex];
+		for (const int32 Dependency : Components.GetDependencies(Node))
+		{
+			if (Components.GetComponent(Dependency) != Component)
+			{
+				continue;
+			}
+
+			if (Dependency == StartNode)
+			{
+				LastNode = Node;
+				break;
+			}
+
+			if (Predecessors.Contains(Dependency) == false)
+			{
+				Predecessors.Add(Dependency, Node);
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	// Walk back from the last node of the cycle to the start node
+	TArray<int32> ReversedPath;
+	for (int32 Node = LastNode; Node != StartNode && Node != INDEX_NONE; Node = Predecessors.Contains(Node) ? Predecessors[Node] : StartNode)
+	{
+		ReversedPath.Add(Node);
+	}
+
+	OutCyclePath.Add(Components.GetPackageName(StartNode));
+	for (int32 PathIndex = ReversedPath.Num() - 1; PathIndex >= 0; --PathIndex)
+	{
+		OutCyclePath.Add(Components.GetPackageName(ReversedPath[PathIndex]));
+	}
+	OutCyclePath.Add(Components.GetPackageName(StartNode));
+}
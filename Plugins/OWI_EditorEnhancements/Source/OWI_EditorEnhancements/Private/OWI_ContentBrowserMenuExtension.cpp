@@ -1,98 +1,171 @@
-// Copyright Offworld Industries
-
-#include "OWI_ContentBrowserMenuExtension.h"
-#include "OWI_UnReleasedAssetsHandler.h"
-
-#define LOCTEXT_NAMESPACE "OWI_ContentBrowserMenuExtension"
-
-void FOWIContentBrowserMenuExtension::AddMenuEntry(FMenuBuilder& MenuBuilder, const TArray<FString> SelectedPaths)
-{
-	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
-	const EPathState PathState = UnReleasedAssetsHandler->GetFolderState(SelectedPaths); 
-
-	if (PathState == None)
-	{
-		return;
-	}
-	
-	const bool PluralFolders = SelectedPaths.Num() > 1;
-	
-	FString Text;
-	const FString FolderText = FString(" Folder").Append(PluralFolders ? "s" : "");
-	FString TooltipText = FString("Mark th").Append(PluralFolders ? "is" : "ese").Append(FolderText).Append(" as ");
-    switch (PathState)
-    {
-	    case None:
-	    	return;
-	    case Released:
-	    	Text = "Unrelease";
-    		break;
-	    case Unreleased:
-	    	Text = "Release";
-    		break;
-	    case Mixed:
-	    	Text = "UnRelease";
-    		break;
-    }
-	TooltipText.Append(Text).Append("d");
-	Text.Append(FolderText);
-	
-	MenuBuilder.BeginSection(NAME_None, FText::FromString("OWI Editor Enhancements"));
-	{
-    	if (PathState != Mixed)
-    	{
-    		MenuBuilder.AddMenuEntry
-             (
-                 FText::FromString(Text),
-                 FText::FromString(TooltipText),
-                 FSlateIcon(),
-                 FUIAction(FExecuteAction::CreateRaw(this,
-                 	PathState == Released ? &FOWIContentBrowserMenuExtension::OnUnreleasedClicked : &FOWIContentBrowserMenuExtension::OnReleasedClicked,
-                 	SelectedPaths))
-             );
-    	} else
-    	{
-    		MenuBuilder.AddSubMenu(FText::FromString("UnRelease Folders"),
-            FText::FromString(TooltipText),
-            FNewMenuDelegate::CreateRaw(this, &FOWIContentBrowserMenuExtension::FillSubmenu, SelectedPaths));
-    	}
-	}
-	MenuBuilder.EndSection();
-}
-
-void FOWIContentBrowserMenuExtension::FillSubmenu(FMenuBuilder& MenuBuilder, const TArray<FString> SelectedPaths)
-{
-	MenuBuilder.AddMenuEntry(
-        FText::FromString("Release Folders"),
-        FText::FromString("Mark these Folders as Released"),
-        FSlateIcon(),
-        FUIAction(FExecuteAction::CreateRaw(this, &FOWIContentBrowserMenuExtension::OnReleasedClicked, SelectedPaths))
-    );
-	MenuBuilder.AddMenuEntry(
-        FText::FromString("Unrelease Folders"),
-        FText::FromString("Mark these Folders as Unreleased"),
-        FSlateIcon(),
-        FUIAction(FExecuteAction::CreateRaw(this, &FOWIContentBrowserMenuExtension::OnUnreleasedClicked, SelectedPaths))
-    );
-}
-
-void FOWIContentBrowserMenuExtension::OnReleasedClicked(TArray<FString> SelectedPaths) const
-{
-	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
-	for (const auto Path : SelectedPaths)
-	{
-		UnReleasedAssetsHandler->ReleaseFolder(Path);
-	}
-}
-
-void FOWIContentBrowserMenuExtension::OnUnreleasedClicked(TArray<FString> SelectedPaths) const
-{
-	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
-	for (const auto Path : SelectedPaths)
-	{
-		UnReleasedAssetsHandler->UnreleaseFolder(Path);
-	}
-}
-
-
-#undef LOCTEXT_NAMESPACE
+// Copyright Offworld Industries
+
+#include "OWI_ContentBrowserMenuExtension.h"
+#include "AssetRegistryModule.h"
+#include "Misc/MessageDialog.h"
+#include "Misc/ScopedSlowTask.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_UnReleasedAssetsHandler.h"
+
+#define LOCTEXT_NAMESPACE "OWI_ContentBrowserMenuExtension"
+
+void FOWIContentBrowserMenuExtension::AddMenuEntry(FMenuBuilder& MenuBuilder, const TArray<FString> SelectedPaths)
+{
+	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
+	const EPathState PathState = UnReleasedAssetsHandler->GetFolderState(SelectedPaths); 
+	const bool bNamingConventionsEnabled = GetDefault<UOWINamingConventionHandlerSettings>()->bEnabled;
+
+	if (PathState == None && bNamingConventionsEnabled == false)
+	{
+		return;
+	}
+	
+	const bool PluralFolders = SelectedPaths.Num() > 1;
+	
+	FString Text;
+	const FString FolderText = FString(" Folder").Append(PluralFolders ? "s" : "");
+	FString TooltipText = FString("Mark th").Append(PluralFolders ? "is" : "ese").Append(FolderText).Append(" as ");
+    switch (PathState)
+    {
+	    case None:
+	    	break;
+	    case Released:
+	    	Text = "Unrelease";
+    		break;
+	    case Unreleased:
+	    	Text = "Release";
+    		break;
+	    case Mixed:
+	    	Text = "UnRelease";
+    		break;
+    }
+	TooltipText.Append(Text).Append("d");
+	Text.Append(FolderText);
+	
+	MenuBuilder.BeginSection(NAME_None, FText::FromString("OWI Editor Enhancements"));
+	{
+    	if (PathState == Released || PathState == Unreleased)
+    	{
+    		MenuBuilder.AddMenuEntry
+             (
+                 FText::FromString(Text),
+                 FText::FromString(TooltipText),
+                 FSlateIcon(),
+                 FUIAction(FExecuteAction::CreateRaw(this,
+                 	PathState == Released ? &FOWIContentBrowserMenuExtension::OnUnreleasedClicked : &FOWIContentBrowserMenuExtension::OnReleasedClicked,
+                 	SelectedPaths))
+             );
+    	} else if (PathState == Mixed)
+    	{
+    		MenuBuilder.AddSubMenu(FText::FromString("UnRelease Folders"),
+            FText::FromString(TooltipText),
+            FNewMenuDelegate::CreateRaw(this, &FOWIContentBrowserMenuExtension::FillSubmenu, SelectedPaths));
+    	}
+
+		if (bNamingConventionsEnabled)
+		{
+			MenuBuilder.AddMenuEntry(
+				FText::FromString("Fix All Naming Violations"),
+				FText::FromString(FString("Rename every Asset in th").Append(PluralFolders ? "ese" : "is").Append(FolderText).Append(" to match the Naming Conventions")),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateRaw(this, &FOWIContentBrowserMenuExtension::OnFixNamingConventionsClicked, SelectedPaths))
+			);
+		}
+	}
+	MenuBuilder.EndSection();
+}
+
+void FOWIContentBrowserMenuExtension::FillSubmenu(FMenuBuilder& MenuBuilder, const TArray<FString> SelectedPaths)
+{
+	MenuBuilder.AddMenuEntry(
+        FText::FromString("Release Folders"),
+        FText::FromString("Mark these Folders as Released"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateRaw(this, &FOWIContentBrowserMenuExtension::OnReleasedClicked, SelectedPaths))
+    );
+	MenuBuilder.AddMenuEntry(
+        FText::FromString("Unrelease Folders"),
+        FText::FromString("Mark these Folders as Unreleased"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateRaw(this, &FOWIContentBrowserMenuExtension::OnUnreleasedClicked, SelectedPaths))
+    );
+}
+
+void FOWIContentBrowserMenuExtension::OnReleasedClicked(TArray<FString> SelectedPaths) const
+{
+	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
+	UnReleasedAssetsHandler->ReleaseFolders(SelectedPaths);
+}
+
+void FOWIContentBrowserMenuExtension::OnUnreleasedClicked(TArray<FString> SelectedPaths) const
+{
+	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
+	UnReleasedAssetsHandler->UnreleaseFolders(SelectedPaths);
+}
+
+void FOWIContentBrowserMenuExtension::OnFixNamingConventionsClicked(TArray<FString> SelectedPaths) const
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	TArray<FAssetData> Assets;
+	TSet<FName> ObjectPaths;
+	for (const FString& Path : SelectedPaths)
+	{
+		TArray<FAssetData> PathAssets;
+		AssetRegistry.GetAssetsByPath(*Path, PathAssets, true);
+
+		// Selected folders may contain each other, every Asset is only checked and renamed once
+		for (FAssetData& AssetData : PathAssets)
+		{
+			bool bAlreadyAdded = false;
+			ObjectPaths.Add(AssetData.ObjectPath, &bAlreadyAdded);
+			if (bAlreadyAdded == false)
+			{
+				Assets.Add(MoveTemp(AssetData));
+			}
+		}
+	}
+
+	UOWINamingConventionHandler* NamingConventionHandler = NewObject<UOWINamingConventionHandler>();
+
+	TArray<UObject*> ViolatingAssets;
+	{
+		FScopedSlowTask SlowTask(Assets.Num(), LOCTEXT("FindNamingViolations", "Finding naming convention violations..."));
+		SlowTask.MakeDialog(true);
+		for (const FAssetData& AssetData : Assets)
+		{
+			SlowTask.EnterProgressFrame();
+			if (SlowTask.ShouldCancel())
+			{
+				return;
+			}
+
+			// Only the violating Assets need to be loaded for renaming
+			FString ValidationError;
+			if (NamingConventionHandler->NamingConventionIsViolated(AssetData, ValidationError))
+			{
+				ViolatingAssets.Add(AssetData.GetAsset());
+			}
+		}
+	}
+
+	if (ViolatingAssets.Num() == 0)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("NoNamingViolations", "No naming convention violations found."));
+		return;
+	}
+
+	const FText Question = FText::Format(LOCTEXT("ConfirmFixNamingViolations", "Rename {0} Assets to match the Naming Conventions? Referencers will be updated and saved."), ViolatingAssets.Num());
+	if (FMessageDialog::Open(EAppMsgType::YesNo, Question) != EAppReturnType::Yes)
+	{
+		return;
+	}
+
+	const int32 NumRenamed = NamingConventionHandler->RenameAssets(ViolatingAssets);
+	if (NumRenamed < ViolatingAssets.Num())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::Format(LOCTEXT("NamingViolationsLeft", "{0} of {1} Assets could not be renamed, see the Output Log for details."),
+			ViolatingAssets.Num() - NumRenamed, ViolatingAssets.Num()));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
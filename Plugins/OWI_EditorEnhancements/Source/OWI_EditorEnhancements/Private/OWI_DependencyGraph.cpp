@@ -0,0 +1,424 @@
+// Copyright Offworld Industries
+
+#include "OWI_DependencyGraph.h"
+#include "AssetRegistryModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "OWI_ValidationStats.h"
+
+namespace OWIDependencyGraph
+{
+	constexpr uint32 FileMagic = 0x4F574447;
+
+	// Bump whenever the file layout or the meaning of the stored dependencies changes
+	constexpr uint32 FileVersion = 1;
+
+	template <typename T>
+	void AppendBytes(TArray<uint8>& Data, const T* Values, const int32 Num)
+	{
+		Data.Append(reinterpret_cast<const uint8*>(Values), Num * sizeof(T));
+	}
+}
+
+FOWIDependencyGraph::~FOWIDependencyGraph()
+{
+	Unmap();
+}
+
+void FOWIDependencyGraph::Initialize()
+{
+	Load();
+
+	PackageChangeListener.Start([this](const FName PackageName)
+	{
+		Invalidate(PackageName);
+	}, false);
+}
+
+void FOWIDependencyGraph::Shutdown()
+{
+	PackageChangeListener.Stop();
+
+	if (bDirty)
+	{
+		Save();
+	}
+	Unmap();
+}
+
+void FOWIDependencyGraph::GetDependencies(const FName PackageName, const IAssetRegistry& AssetRegistry, FOWIPackageDependencies& OutDependencies)
+{
+	OutDependencies.PackageName = PackageName;
+	OutDependencies.Dependencies.Reset();
+	OutDependencies.NumHardDependencies = 0;
+
+	const int32 PackageIndex = FindValidSnapshotPackage(PackageName, AssetRegistry);
+	if (PackageIndex != INDEX_NONE)
+	{
+		OutDependencies.Dependencies.Reserve(Offsets[PackageIndex + 1] - Offsets[PackageIndex]);
+		for (uint32 EdgeIndex = Offsets[PackageIndex]; EdgeIndex < Offsets[PackageIndex + 1]; ++EdgeIndex)
+		{
+			OutDependencies.Dependencies.Add(PackageNames[Edges[EdgeIndex]]);
+		}
+		OutDependencies.NumHardDependencies = NumHardDependencies[PackageIndex];
+		return;
+	}
+
+	const FOverlayEntry& Entry = FindOrAddOverlayEntry(PackageName, AssetRegistry);
+	OutDependencies.Dependencies = Entry.Dependencies;
+	OutDependencies.NumHardDependencies = Entry.NumHardDependencies;
+}
+
+void FOWIDependencyGraph::GetHardDependencies(const FName PackageName, const IAssetRegistry& AssetRegistry, TArray<FName>& OutDependencies)
+{
+	const int32 PackageIndex = FindValidSnapshotPackage(PackageName, AssetRegistry);
+	if (PackageIndex != INDEX_NONE)
+	{
+		const uint32 FirstEdge = Offsets[PackageIndex];
+		for (uint32 EdgeIndex = FirstEdge; EdgeIndex < FirstEdge + NumHardDependencies[PackageIndex]; ++EdgeIndex)
+		{
+			OutDependencies.Add(PackageNames[Edges[EdgeIndex]]);
+		}
+		return;
+	}
+
+	const FOverlayEntry& Entry = FindOrAddOverlayEntry(PackageName, AssetRegistry);
+	OutDependencies.Append(Entry.Dependencies.GetData(), Entry.NumHardDependencies);
+}
+
+void FOWIDependencyGraph::Invalidate(const FName PackageName)
+{
+	if (const int32* PackageIndex = PackageIndices.Find(PackageName))
+	{
+		StalePackages[*PackageIndex] = true;
+	}
+	Overlay.Remove(PackageName);
+}
+
+int32 FOWIDependencyGraph::Num() const
+{
+	int32 NumStored = Overlay.Num();
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		if (PackageGuids[PackageIndex].IsValid() && StalePackages[PackageIndex] == false && Overlay.Contains(PackageNames[PackageIndex]) == false)
+		{
+			++NumStored;
+		}
+	}
+
+	return NumStored;
+}
+
+bool FOWIDependencyGraph::Load()
+{
+	Unmap();
+
+	const FString FilePath = GetGraphFilePath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.FileExists(*FilePath) == false)
+	{
+		return false;
+	}
+
+	// Only the package names are read, everything else is paged in when it is used
+	MappedFile = PlatformFile.OpenMapped(*FilePath);
+	if (MappedFile != nullptr)
+	{
+		MappedRegion = MappedFile->MapRegion(0, MappedFile->GetFileSize());
+	}
+
+	bool bLoaded = false;
+	if (MappedRegion != nullptr)
+	{
+		bLoaded = ReadSnapshot(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+	} else if (FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+	{
+		bLoaded = ReadSnapshot(FileData.GetData(), FileData.Num());
+	}
+
+	if (bLoaded == false)
+	{
+		Unmap();
+	}
+	return bLoaded;
+}
+
+bool FOWIDependencyGraph::Save()
+{
+	TArray<FName> NewPackageNames;
+	TMap<FName, int32> NewPackageIndices;
+	TArray<FGuid> NewPackageGuids;
+	TArray<uint32> NewNumHardDependencies;
+	TArray<const FName*> NewDependencies;
+	TArray<int32> NewNumDependencies;
+
+	// Packages with stored dependencies come first, so their offsets can be written in order
+	auto AddStoredPackage = [&](const FName PackageName, const FGuid& PackageGuid, const int32 NumHard)
+	{
+		NewPackageIndices.Add(PackageName, NewPackageNames.Add(PackageName));
+		NewPackageGuids.Add(PackageGuid);
+		NewNumHardDependencies.Add(NumHard);
+	};
+
+	// The snapshot edges are package indices, resolved into names once to share the code with the overlay
+	TArray<FName> SnapshotDependencies;
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		if (PackageGuids[PackageIndex].IsValid() && StalePackages[PackageIndex] == false && Overlay.Contains(PackageNames[PackageIndex]) == false)
+		{
+			AddStoredPackage(PackageNames[PackageIndex], PackageGuids[PackageIndex], NumHardDependencies[PackageIndex]);
+		}
+	}
+	SnapshotDependencies.Reserve(Offsets == nullptr ? 0 : Offsets[PackageNames.Num()]);
+	TArray<int32> SnapshotStarts;
+	for (const FName& PackageName : NewPackageNames)
+	{
+		const int32 PackageIndex = PackageIndices.FindChecked(PackageName);
+		SnapshotStarts.Add(SnapshotDependencies.Num());
+		NewNumDependencies.Add(Offsets[PackageIndex + 1] - Offsets[PackageIndex]);
+		for (uint32 EdgeIndex = Offsets[PackageIndex]; EdgeIndex < Offsets[PackageIndex + 1]; ++EdgeIndex)
+		{
+			SnapshotDependencies.Add(PackageNames[Edges[EdgeIndex]]);
+		}
+	}
+	for (const int32 SnapshotStart : SnapshotStarts)
+	{
+		NewDependencies.Add(SnapshotDependencies.GetData() + SnapshotStart);
+	}
+
+	// Packages that are not saved yet have no guid to validate their dependencies with
+	for (const TPair<FName, FOverlayEntry>& Pair : Overlay)
+	{
+		if (Pair.Value.PackageGuid.IsValid())
+		{
+			AddStoredPackage(Pair.Key, Pair.Value.PackageGuid, Pair.Value.NumHardDependencies);
+			NewDependencies.Add(Pair.Value.Dependencies.GetData());
+			NewNumDependencies.Add(Pair.Value.Dependencies.Num());
+		}
+	}
+
+	const int32 NumStoredPackages = NewPackageNames.Num();
+	TArray<uint32> NewOffsets;
+	TArray<uint32> NewEdges;
+	NewOffsets.Reserve(NumStoredPackages + 1);
+	for (int32 PackageIndex = 0; PackageIndex < NumStoredPackages; ++PackageIndex)
+	{
+		NewOffsets.Add(NewEdges.Num());
+		for (int32 DependencyIndex = 0; DependencyIndex < NewNumDependencies[PackageIndex]; ++DependencyIndex)
+		{
+			const FName Dependency = NewDependencies[PackageIndex][DependencyIndex];
+			int32* DependencyPackageIndex = NewPackageIndices.Find(Dependency);
+			if (DependencyPackageIndex == nullptr)
+			{
+				// Packages that are only known as a dependency have no dependencies stored themselves
+				DependencyPackageIndex = &NewPackageIndices.Add(Dependency, NewPackageNames.Add(Dependency));
+				NewPackageGuids.Add(FGuid());
+				NewNumHardDependencies.Add(0);
+			}
+			NewEdges.Add(*DependencyPackageIndex);
+		}
+	}
+	while (NewOffsets.Num() <= NewPackageNames.Num())
+	{
+		NewOffsets.Add(NewEdges.Num());
+	}
+
+	TArray<uint8> Names;
+	for (const FName& PackageName : NewPackageNames)
+	{
+		const FTCHARToUTF8 Name(*PackageName.ToString());
+		Names.Append(reinterpret_cast<const uint8*>(Name.Get()), Name.Length());
+		Names.Add(0);
+	}
+
+	FFileHeader Header;
+	Header.Magic = OWIDependencyGraph::FileMagic;
+	Header.Version = OWIDependencyGraph::FileVersion;
+	Header.NumPackages = NewPackageNames.Num();
+	Header.NumEdges = NewEdges.Num();
+	Header.NamesSize = Names.Num();
+
+	TArray<uint8> Data;
+	OWIDependencyGraph::AppendBytes(Data, &Header, 1);
+	OWIDependencyGraph::AppendBytes(Data, NewPackageGuids.GetData(), NewPackageGuids.Num());
+	OWIDependencyGraph::AppendBytes(Data, NewNumHardDependencies.GetData(), NewNumHardDependencies.Num());
+	OWIDependencyGraph::AppendBytes(Data, NewOffsets.GetData(), NewOffsets.Num());
+	OWIDependencyGraph::AppendBytes(Data, NewEdges.GetData(), NewEdges.Num());
+	Data.Append(Names);
+
+	// The mapping keeps the file open, all views were resolved into the new arrays above
+	Unmap();
+	if (FFileHelper::SaveArrayToFile(Data, *GetGraphFilePath()) == false)
+	{
+		Load();
+		return false;
+	}
+
+	Overlay.Reset();
+	bDirty = false;
+	Load();
+	return true;
+}
+
+FString FOWIDependencyGraph::GetGraphFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OWI_EditorEnhancements"), TEXT("DependencyGraph.bin"));
+}
+
+bool FOWIDependencyGraph::ReadSnapshot(const uint8* Data, const int64 Size)
+{
+	if (Size < static_cast<int64>(sizeof(FFileHeader)))
+	{
+		return false;
+	}
+
+	FFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(FFileHeader));
+	const int64 NumPackages = Header.NumPackages;
+	const int64 ExpectedSize = sizeof(FFileHeader)
+		+ NumPackages * sizeof(FGuid)
+		+ NumPackages * sizeof(uint32)
+		+ (NumPackages + 1) * sizeof(uint32)
+		+ static_cast<int64>(Header.NumEdges) * sizeof(uint32)
+		+ Header.NamesSize;
+	if (Header.Magic != OWIDependencyGraph::FileMagic || Header.Version != OWIDependencyGraph::FileVersion || ExpectedSize != Size)
+	{
+		return false;
+	}
+
+	const uint8* Position = Data + sizeof(FFileHeader);
+	PackageGuids = reinterpret_cast<const FGuid*>(Position);
+	Position += NumPackages * sizeof(FGuid);
+	NumHardDependencies = reinterpret_cast<const uint32*>(Position);
+	Position += NumPackages * sizeof(uint32);
+	Offsets = reinterpret_cast<const uint32*>(Position);
+	Position += (NumPackages + 1) * sizeof(uint32);
+	Edges = reinterpret_cast<const uint32*>(Position);
+	Position += static_cast<int64>(Header.NumEdges) * sizeof(uint32);
+
+	// A damaged file must not lead to reading outside of it later on
+	if (Offsets[0] != 0 || Offsets[NumPackages] != Header.NumEdges)
+	{
+		return false;
+	}
+	for (int64 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		if (Offsets[PackageIndex] > Offsets[PackageIndex + 1] || NumHardDependencies[PackageIndex] > Offsets[PackageIndex + 1] - Offsets[PackageIndex])
+		{
+			return false;
+		}
+	}
+	for (uint32 EdgeIndex = 0; EdgeIndex < Header.NumEdges; ++EdgeIndex)
+	{
+		if (Edges[EdgeIndex] >= NumPackages)
+		{
+			return false;
+		}
+	}
+
+	PackageNames.Reserve(NumPackages);
+	PackageIndices.Reserve(NumPackages);
+	const uint8* NamesEnd = Position + Header.NamesSize;
+	while (Position < NamesEnd && PackageNames.Num() < NumPackages)
+	{
+		const uint8* NameEnd = Position;
+		while (NameEnd < NamesEnd && *NameEnd != 0)
+		{
+			++NameEnd;
+		}
+		if (NameEnd == NamesEnd)
+		{
+			return false;
+		}
+
+		const FUTF8ToTCHAR Name(reinterpret_cast<const ANSICHAR*>(Position), NameEnd - Position);
+		const FName PackageName(Name.Length(), Name.Get());
+		PackageIndices.Add(PackageName, PackageNames.Add(PackageName));
+		Position = NameEnd + 1;
+	}
+	if (PackageNames.Num() != NumPackages)
+	{
+		return false;
+	}
+
+	StalePackages.Init(false, NumPackages);
+	return true;
+}
+
+void FOWIDependencyGraph::Unmap()
+{
+	PackageNames.Reset();
+	PackageIndices.Reset();
+	StalePackages.Reset();
+	PackageGuids = nullptr;
+	NumHardDependencies = nullptr;
+	Offsets = nullptr;
+	Edges = nullptr;
+
+	delete MappedRegion;
+	MappedRegion = nullptr;
+	delete MappedFile;
+	MappedFile = nullptr;
+	FileData.Empty();
+}
+
+int32 FOWIDependencyGraph::FindValidSnapshotPackage(const FName PackageName, const IAssetRegistry& AssetRegistry) const
+{
+	const int32* PackageIndex = PackageIndices.Find(PackageName);
+	if (PackageIndex == nullptr
+		|| StalePackages[*PackageIndex]
+		|| PackageGuids[*PackageIndex].IsValid() == false
+		|| PackageGuids[*PackageIndex] != FOWIPackageChangeListener::GetPackageGuid(PackageName, AssetRegistry))
+	{
+		return INDEX_NONE;
+	}
+
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::DependencyGraphHits);
+	return *PackageIndex;
+}
+
+const FOWIDependencyGraph::FOverlayEntry& FOWIDependencyGraph::FindOrAddOverlayEntry(const FName PackageName, const IAssetRegistry& AssetRegistry)
+{
+	// Unsaved packages have no guid, their entry is kept until the Asset Registry reports a change
+	const FGuid PackageGuid = FOWIPackageChangeListener::GetPackageGuid(PackageName, AssetRegistry);
+	FOverlayEntry& Entry = Overlay.FindOrAdd(PackageName);
+	if (Entry.bFetched && Entry.PackageGuid == PackageGuid)
+	{
+		FOWIValidationStats::Get().Add(EOWIValidationCounter::DependencyGraphHits);
+		return Entry;
+	}
+
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::RegistryQueries);
+	Entry.PackageGuid = PackageGuid;
+	Entry.bFetched = true;
+	Entry.Dependencies.Reset();
+	Entry.NumHardDependencies = 0;
+
+	// Every dependency comes tagged with its properties, so hard and soft ones are told apart without a second query
+	TArray<FAssetDependency> TaggedDependencies;
+	AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), TaggedDependencies, UE::AssetRegistry::EDependencyCategory::Package);
+
+	Entry.Dependencies.Reserve(TaggedDependencies.Num());
+	for (const FAssetDependency& Dependency : TaggedDependencies)
+	{
+		if (EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard))
+		{
+			Entry.Dependencies.Add(Dependency.AssetId.PackageName);
+		}
+	}
+	Entry.NumHardDependencies = Entry.Dependencies.Num();
+
+	for (const FAssetDependency& Dependency : TaggedDependencies)
+	{
+		if (EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard) == false)
+		{
+			Entry.Dependencies.Add(Dependency.AssetId.PackageName);
+		}
+	}
+
+	bDirty |= PackageGuid.IsValid();
+	return Entry;
+}
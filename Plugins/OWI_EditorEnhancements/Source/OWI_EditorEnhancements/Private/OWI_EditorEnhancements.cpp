@@ -1,44 +1,134 @@
-// Copyright Offworld Industries
-
-#include "OWI_EditorEnhancements.h"
-#include "ContentBrowserModule.h"
-#include "OWI_ContentBrowserMenuExtension.h"
-#include "OWI_UnReleasedAssetsHandler.h"
-
-#define LOCTEXT_NAMESPACE "OWI_EditorEnhancementsModule"
-
-void FOWIEditorEnhancementsModule::StartupModule()
-{
-	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
-	ContentBrowserModule.GetAllPathViewContextMenuExtenders()
-		.Add(FContentBrowserMenuExtender_SelectedPaths::CreateRaw(this, &FOWIEditorEnhancementsModule::ContentBrowserExtender));
-
-	// Unfortunately the ColorPath changes can't be synchronised so make sure we mark all folder accordingly
-	UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
-	UnReleasedAssetsHandler->UpdateFolderColorsOnStart();
-
-	// Custom Shaders folder for USH/USF shaders
-	FString ShaderDirectory = FPaths::Combine(FPaths::ProjectDir(), TEXT("Shaders"));
-	if (FPaths::DirectoryExists(ShaderDirectory) && FPaths::ValidatePath(ShaderDirectory))
-	{
-		AddShaderSourceDirectoryMapping("/Shaders", ShaderDirectory);
-	}
-}
-
-void FOWIEditorEnhancementsModule::ShutdownModule()
-{
-	ResetAllShaderSourceDirectoryMappings();
-}
-TSharedRef<FExtender> FOWIEditorEnhancementsModule::ContentBrowserExtender(const TArray<FString>& Path)
-{
-	Extension = MakeShareable(new FOWIContentBrowserMenuExtension());
-	TSharedPtr<FExtender> MenuExtender = MakeShareable(new FExtender());
-	// For a more generic approach use "FolderContext" as ExtensionHook but this will sort it further up in the list
-	MenuExtender->AddMenuExtension("PathContextSourceControl", EExtensionHook::After, TSharedPtr<FUICommandList>(),
-                       FMenuExtensionDelegate::CreateSP(Extension.ToSharedRef(), &FOWIContentBrowserMenuExtension::AddMenuEntry, Path));
-	return MenuExtender.ToSharedRef();
-}
-
-#undef LOCTEXT_NAMESPACE
-	
-IMPLEMENT_MODULE(FOWIEditorEnhancementsModule, OWI_EditorEnhancements)
+// Copyright Offworld Industries
+
+#include "OWI_EditorEnhancements.h"
+#include "ContentBrowserModule.h"
+#include "Editor.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/HotReloadInterface.h"
+#include "OWI_ContentBrowserMenuExtension.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_UnReleasedAssetsHandler.h"
+
+#define LOCTEXT_NAMESPACE "OWI_EditorEnhancementsModule"
+
+void FOWIEditorEnhancementsModule::StartupModule()
+{
+	FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>(TEXT("ContentBrowser"));
+	ContentBrowserModule.GetAllPathViewContextMenuExtenders()
+		.Add(FContentBrowserMenuExtender_SelectedPaths::CreateRaw(this, &FOWIEditorEnhancementsModule::ContentBrowserExtender));
+
+	// Resolved classes become invalid when classes are reinstanced, reloaded or garbage collected
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOWIEditorEnhancementsModule::OnPostEngineInit);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FOWIEditorEnhancementsModule::OnPostGarbageCollect);
+	if (IHotReloadInterface* HotReload = FModuleManager::GetModulePtr<IHotReloadInterface>(TEXT("HotReload")))
+	{
+		HotReloadHandle = HotReload->OnHotReload().AddRaw(this, &FOWIEditorEnhancementsModule::OnHotReload);
+	}
+
+	// Materials are classified by their base material, which may change with any saved material
+	ObjectSavedHandle = FCoreUObjectDelegates::OnObjectSaved.AddRaw(this, &FOWIEditorEnhancementsModule::OnObjectSaved);
+	GetExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddRaw(this, &FOWIEditorEnhancementsModule::OnGetExtraObjectTags);
+
+	DependencyGraph.Initialize();
+
+	// Custom Shaders folder for USH/USF shaders
+	FString ShaderDirectory = FPaths::Combine(FPaths::ProjectDir(), TEXT("Shaders"));
+	if (FPaths::DirectoryExists(ShaderDirectory) && FPaths::ValidatePath(ShaderDirectory))
+	{
+		AddShaderSourceDirectoryMapping("/Shaders", ShaderDirectory);
+	}
+}
+
+void FOWIEditorEnhancementsModule::ShutdownModule()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	if (IHotReloadInterface* HotReload = FModuleManager::GetModulePtr<IHotReloadInterface>(TEXT("HotReload")))
+	{
+		HotReload->OnHotReload().Remove(HotReloadHandle);
+	}
+	FCoreUObjectDelegates::OnObjectSaved.Remove(ObjectSavedHandle);
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(GetExtraObjectTagsHandle);
+	if (GEditor != nullptr)
+	{
+		GEditor->OnObjectsReplaced().Remove(ObjectsReplacedHandle);
+	}
+
+	DependencyGraph.Shutdown();
+
+	ResetAllShaderSourceDirectoryMappings();
+}
+
+FOWIDependencyGraph& FOWIEditorEnhancementsModule::GetDependencyGraph()
+{
+	return FModuleManager::GetModuleChecked<FOWIEditorEnhancementsModule>(TEXT("OWI_EditorEnhancements")).DependencyGraph;
+}
+
+void FOWIEditorEnhancementsModule::OnPostEngineInit()
+{
+	// GEditor doesn't exist yet while the module starts up
+	if (GEditor != nullptr)
+	{
+		ObjectsReplacedHandle = GEditor->OnObjectsReplaced().AddRaw(this, &FOWIEditorEnhancementsModule::OnObjectsReplaced);
+	}
+
+	// Unfortunately the ColorPath changes can't be synchronised so make sure we mark all folder accordingly
+	// Done once the Editor is up instead of while loading the module, usually the colors are up to date already
+	if (IsRunningCommandlet() == false)
+	{
+		UOWIUnReleasedAssetsHandler* UnReleasedAssetsHandler = NewObject<UOWIUnReleasedAssetsHandler>();
+		UnReleasedAssetsHandler->UpdateFolderColorsOnStart();
+	}
+}
+
+void FOWIEditorEnhancementsModule::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	InvalidateClassCaches();
+}
+
+void FOWIEditorEnhancementsModule::OnHotReload(bool bWasTriggeredAutomatically)
+{
+	InvalidateClassCaches();
+}
+
+void FOWIEditorEnhancementsModule::OnPostGarbageCollect()
+{
+	// Classes that survived are still resolved correctly, only the collected ones have to go
+	GetMutableDefault<UOWINamingConventionHandlerSettings>()->RemoveStaleClasses();
+}
+
+void FOWIEditorEnhancementsModule::OnObjectSaved(UObject* Object)
+{
+	// Saving happens before the Asset Registry tags are gathered, so the tag below is already up to date
+	if (Object != nullptr && Object->IsA<UMaterialInterface>())
+	{
+		GetMutableDefault<UOWINamingConventionHandlerSettings>()->InvalidateResolvedMaterial(FName(*Object->GetPathName()));
+	}
+}
+
+void FOWIEditorEnhancementsModule::OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+	if (const UMaterialInterface* Material = Cast<UMaterialInterface>(Object))
+	{
+		const bool bPostProcess = UOWINamingConventionHandler::IsPostProcessMaterial(Material);
+		OutTags.Add(UObject::FAssetRegistryTag(UOWINamingConventionHandler::PostProcessMaterialTag, bPostProcess ? TEXT("True") : TEXT("False"), UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+
+void FOWIEditorEnhancementsModule::InvalidateClassCaches()
+{
+	GetMutableDefault<UOWINamingConventionHandlerSettings>()->InvalidateCaches();
+}
+TSharedRef<FExtender> FOWIEditorEnhancementsModule::ContentBrowserExtender(const TArray<FString>& Path)
+{
+	Extension = MakeShareable(new FOWIContentBrowserMenuExtension());
+	TSharedPtr<FExtender> MenuExtender = MakeShareable(new FExtender());
+	// For a more generic approach use "FolderContext" as ExtensionHook but this will sort it further up in the list
+	MenuExtender->AddMenuExtension("PathContextSourceControl", EExtensionHook::After, TSharedPtr<FUICommandList>(),
+                       FMenuExtensionDelegate::CreateSP(Extension.ToSharedRef(), &FOWIContentBrowserMenuExtension::AddMenuEntry, Path));
+	return MenuExtender.ToSharedRef();
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FOWIEditorEnhancementsModule, OWI_EditorEnhancements)
@@ -1,55 +1,182 @@
-// Copyright Offworld Industries
-
-#include "OWI_EditorValidator.h"
-#include "OWI_ReferenceRulesHandler.h"
-#include "OWI_NamingConventionHandler.h"
-
-bool UOWIEditorValidator::IsEnabled() const
-{
-	return GetDefault<UOWINamingConventionHandlerSettings>()->bEnabled || GetDefault<UOWIReferenceRulesHandlerSettings>()->bEnabled;
-}
-
-bool UOWIEditorValidator::CanValidateAsset_Implementation(UObject* InAsset) const
-{	
-	if (nullptr == InAsset)
-	{
-		return false;
-	}
-
-	if (NewObject<UOWIReferenceRulesHandler>()->RuleCanBeApplied(InAsset->GetPathName()))
-	{
-		return true;
-	}
-
-	if (NewObject<UOWINamingConventionHandler>()->NamingConventionCanBeApplied(InAsset))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-EDataValidationResult UOWIEditorValidator::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
-{
-	FString ValidationError;
-	if (nullptr == InAsset)
-	{
-		AssetFails(InAsset, FText::FromString(ErrorPrefix + "Asset is nullptr"), ValidationErrors);
-		return EDataValidationResult::Invalid;
-	}
-
-	if (NewObject<UOWIReferenceRulesHandler>()->RuleIsViolated(InAsset->GetPathName(), ValidationError))
-	{
-		AssetFails(InAsset, FText::FromString(ErrorPrefix + ValidationError), ValidationErrors);
-		return EDataValidationResult::Invalid;
-	}
-
-	if (NewObject<UOWINamingConventionHandler>()->NamingConventionIsViolated(InAsset, ValidationError))
-	{
-		AssetFails(InAsset, FText::FromString(ErrorPrefix + ValidationError), ValidationErrors);
-		return EDataValidationResult::Invalid;
-	}
-	
-    AssetPasses(InAsset);
-    return EDataValidationResult::Valid;
-}
\ No newline at end of file
+// Copyright Offworld Industries
+
+#include "OWI_EditorValidator.h"
+#include "Containers/Ticker.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_ValidationStats.h"
+
+void UOWIEditorValidator::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Only the validator instances created by the validation subsystem do any work
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	ReferenceRulesHandler = NewObject<UOWIReferenceRulesHandler>(this, TEXT("ReferenceRulesHandler"), RF_Transient);
+	NamingConventionHandler = NewObject<UOWINamingConventionHandler>(this, TEXT("NamingConventionHandler"), RF_Transient);
+	ValidationCache.Initialize();
+}
+
+void UOWIEditorValidator::BeginDestroy()
+{
+	if (bInValidationBatch)
+	{
+		FTicker::GetCoreTicker().RemoveTicker(EndValidationBatchHandle);
+		bInValidationBatch = false;
+	}
+
+	if (HasAnyFlags(RF_ClassDefaultObject) == false)
+	{
+		ValidationCache.Shutdown();
+	}
+
+	Super::BeginDestroy();
+}
+
+bool UOWIEditorValidator::IsEnabled() const
+{
+	return GetDefault<UOWINamingConventionHandlerSettings>()->bEnabled || GetDefault<UOWIReferenceRulesHandlerSettings>()->bEnabled;
+}
+
+bool UOWIEditorValidator::CanValidateAsset_Implementation(UObject* InAsset) const
+{	
+	if (nullptr == InAsset)
+	{
+		return false;
+	}
+
+	if (ReferenceRulesHandler->RuleCanBeApplied(InAsset->GetPathName()))
+	{
+		return true;
+	}
+
+	if (NamingConventionHandler->NamingConventionCanBeApplied(InAsset))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+EDataValidationResult UOWIEditorValidator::ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors)
+{
+	FString ValidationError;
+	if (nullptr == InAsset)
+	{
+		AssetFails(InAsset, FText::FromString(ErrorPrefix + "Asset is nullptr"), ValidationErrors);
+		return EDataValidationResult::Invalid;
+	}
+
+	BeginValidationBatch();
+	OWI_VALIDATION_SCOPE(ValidateAsset);
+
+	// Every check runs even if an earlier one failed, so all problems can be fixed before saving again
+	bool bViolated = false;
+	for (const EOWIValidationCheck Check : { EOWIValidationCheck::ReferenceRules, EOWIValidationCheck::NamingConventions })
+	{
+		if (IsViolated(InAsset, Check, ValidationError))
+		{
+			AddValidationErrors(InAsset, ValidationError, ValidationErrors);
+			bViolated = true;
+		}
+	}
+
+	if (bViolated)
+	{
+		return EDataValidationResult::Invalid;
+	}
+	
+    AssetPasses(InAsset);
+    return EDataValidationResult::Valid;
+}
+
+void UOWIEditorValidator::AddValidationErrors(UObject* InAsset, const FString& ValidationError, TArray<FText>& ValidationErrors)
+{
+	// Checks report one violation per line
+	TArray<FString> Lines;
+	ValidationError.ParseIntoArrayLines(Lines);
+	for (const FString& Line : Lines)
+	{
+		AssetFails(InAsset, FText::FromString(ErrorPrefix + Line), ValidationErrors);
+	}
+}
+
+void UOWIEditorValidator::BeginValidationBatch()
+{
+	if (bInValidationBatch)
+	{
+		return;
+	}
+
+	// All Assets of one validation run are validated within the same frame, so the next tick ends the batch
+	bInValidationBatch = true;
+	ReferenceRulesHandler->ResetCaches();
+	ValidationCache.UpdateSettingsHash();
+	FOWIValidationStats::Get().Reset();
+	EndValidationBatchHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UOWIEditorValidator::EndValidationBatch));
+}
+
+bool UOWIEditorValidator::EndValidationBatch(float DeltaTime)
+{
+	bInValidationBatch = false;
+	ReferenceRulesHandler->ResetCaches();
+	FOWIValidationStats::Get().LogSummary(TEXT("Validation batch"));
+	return false;
+}
+
+bool UOWIEditorValidator::IsViolated(UObject* InAsset, const EOWIValidationCheck Check, FString& ValidationError)
+{
+	// Unsaved changes have no package guid to cache the result for
+	const UPackage* Package = InAsset->GetOutermost();
+	const FGuid PackageGuid = Package->IsDirty() ? FGuid() : Package->GetGuid();
+
+	ValidationError.Empty();
+	FOWIValidationStats& Stats = FOWIValidationStats::Get();
+	const bool bCacheable = FOWIValidationCache::IsCacheable(InAsset->GetClass(), Check);
+	if (bCacheable && ValidationCache.Find(Package->GetFName(), PackageGuid, Check, ValidationError))
+	{
+		Stats.Add(EOWIValidationCounter::ValidationCacheHits);
+	} else
+	{
+		if (bCacheable)
+		{
+			Stats.Add(EOWIValidationCounter::ValidationCacheMisses);
+		}
+
+		// Only what depends on the package alone is cached, see FOWIValidationCache::IsCacheable
+		switch (Check)
+		{
+		case EOWIValidationCheck::ReferenceRules:
+			ReferenceRulesHandler->RuleIsViolated(InAsset->GetPathName(), ValidationError, EOWIReferenceCheckScope::Local);
+			break;
+		case EOWIValidationCheck::NamingConventions:
+			NamingConventionHandler->NamingConventionIsViolated(InAsset, ValidationError);
+			break;
+		default:
+			break;
+		}
+
+		if (bCacheable)
+		{
+			ValidationCache.Add(Package->GetFName(), PackageGuid, Check, ValidationError);
+		}
+	}
+
+	// Circular and transitive dependencies change with any reachable package, so they are always checked
+	FString GraphValidationError;
+	if (Check == EOWIValidationCheck::ReferenceRules && ReferenceRulesHandler->RuleIsViolated(InAsset->GetPathName(), GraphValidationError, EOWIReferenceCheckScope::Graph))
+	{
+		if (ValidationError.IsEmpty() == false)
+		{
+			ValidationError.Append(LINE_TERMINATOR);
+		}
+		ValidationError.Append(GraphValidationError);
+	}
+
+	Stats.Add(EOWIValidationCounter::Violations, ValidationError.IsEmpty() ? 0 : 1);
+	return ValidationError.IsEmpty() == false;
+}
@@ -0,0 +1,146 @@
+// Copyright Offworld Industries
+
+#include "OWI_FolderStateTree.h"
+
+FOWIFolderStateTree::FOWIFolderStateTree()
+{
+	Reset();
+}
+
+void FOWIFolderStateTree::Reset()
+{
+	Paths.Reset();
+	Folders.Reset();
+	Folders.AddDefaulted();
+	NumTracked = 0;
+}
+
+void FOWIFolderStateTree::Build(const TArray<FString>& UnreleasedFolders, const TArray<FString>& ReleasedFolders, const TArray<FString>& MixedFolders)
+{
+	Reset();
+
+	for (const FString& FolderPath : ReleasedFolders)
+	{
+		SetState(FolderPath, Released);
+	}
+
+	for (const FString& FolderPath : MixedFolders)
+	{
+		SetState(FolderPath, Mixed);
+	}
+
+	// Unreleased last, it wins if a folder somehow ended up in more than one array
+	for (const FString& FolderPath : UnreleasedFolders)
+	{
+		SetState(FolderPath, Unreleased);
+	}
+}
+
+void FOWIFolderStateTree::Export(TArray<FString>& OutUnreleasedFolders, TArray<FString>& OutReleasedFolders, TArray<FString>& OutMixedFolders) const
+{
+	OutUnreleasedFolders.Reset();
+	OutReleasedFolders.Reset();
+	OutMixedFolders.Reset();
+
+	for (const FFolder& Folder : Folders)
+	{
+		switch (Folder.State)
+		{
+		case Unreleased:
+			OutUnreleasedFolders.Add(Folder.Path);
+			break;
+		case Released:
+			OutReleasedFolders.Add(Folder.Path);
+			break;
+		case Mixed:
+			OutMixedFolders.Add(Folder.Path);
+			break;
+		case None:
+		default:
+			break;
+		}
+	}
+
+	// Sorted once here instead of on every load, keeps the config file diffs small
+	OutUnreleasedFolders.Sort();
+	OutReleasedFolders.Sort();
+	OutMixedFolders.Sort();
+}
+
+void FOWIFolderStateTree::SetState(const FString& FolderPath, const EPathState State)
+{
+	const int32 NodeIndex = State == None ? Paths.FindNode(FolderPath) : Paths.FindOrAddNode(FolderPath);
+	if (NodeIndex == INDEX_NONE || NodeIndex == 0)
+	{
+		return;
+	}
+	Folders.SetNum(Paths.NumNodes());
+
+	const EPathState OldState = Folders[NodeIndex].State;
+	if (OldState == State)
+	{
+		Folders[NodeIndex].Path = FolderPath;
+		return;
+	}
+
+	Folders[NodeIndex].State = State;
+	Folders[NodeIndex].Path = FolderPath;
+	NumTracked += (State != None ? 1 : 0) - (OldState != None ? 1 : 0);
+
+	// Only the counts of the folders containing this one change
+	for (int32 Ancestor = Paths.GetParent(NodeIndex); Ancestor != INDEX_NONE; Ancestor = Paths.GetParent(Ancestor))
+	{
+		--Folders[Ancestor].NumDescendants[OldState];
+		++Folders[Ancestor].NumDescendants[State];
+	}
+}
+
+EPathState FOWIFolderStateTree::GetState(const FString& FolderPath) const
+{
+	const int32 NodeIndex = Paths.FindNode(FolderPath);
+	return NodeIndex != INDEX_NONE ? Folders[NodeIndex].State : None;
+}
+
+bool FOWIFolderStateTree::IsUnreleased(const FString& FolderPath) const
+{
+	bool bUnreleased = false;
+	Paths.ForEachNodeOnPath(*FolderPath, FolderPath.Len(), [this, &bUnreleased](const int32 NodeIndex)
+	{
+		bUnreleased |= Folders[NodeIndex].State == Unreleased;
+	});
+
+	return bUnreleased;
+}
+
+void FOWIFolderStateTree::GetTrackedAncestors(const FString& FolderPath, const EPathState State, TArray<FString>& OutAncestors) const
+{
+	OutAncestors.Reset();
+
+	TArray<int32, TInlineAllocator<16>> PathNodes;
+	const bool bFound = Paths.ForEachNodeOnPath(*FolderPath, FolderPath.Len(), [&PathNodes](const int32 NodeIndex)
+	{
+		PathNodes.Add(NodeIndex);
+	});
+
+	// If the folder itself has a node it's the last one on the path, but only the folders containing it count
+	const int32 NumAncestors = bFound ? PathNodes.Num() - 1 : PathNodes.Num();
+	for (int32 PathIndex = NumAncestors - 1; PathIndex >= 0; --PathIndex)
+	{
+		const FFolder& Folder = Folders[PathNodes[PathIndex]];
+		if (Folder.State == State)
+		{
+			OutAncestors.Add(Folder.Path);
+		}
+	}
+}
+
+bool FOWIFolderStateTree::HasTrackedDescendants(const FString& FolderPath, const EPathState State) const
+{
+	const int32 NodeIndex = Paths.FindNode(FolderPath);
+	return NodeIndex != INDEX_NONE && Folders[NodeIndex].NumDescendants[State] > 0;
+}
+
+int32 FOWIFolderStateTree::Num() const
+{
+	return NumTracked;
+}
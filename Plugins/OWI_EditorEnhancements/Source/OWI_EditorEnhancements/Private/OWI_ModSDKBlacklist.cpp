@@ -0,0 +1,230 @@
+// Copyright Offworld Industries
+
+#include "OWI_ModSDKBlacklist.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <stdio.h>
+#include <sys/stat.h>
+#endif
+
+namespace OWIModSDKBlacklist
+{
+	/**
+	 * \brief Give the temporary file the permissions of the script, so it stays executable
+	 * \param FilePath The script
+	 * \param TempFilePath The file to replace it with
+	 * \return False if the permissions could not be copied
+	 */
+	bool CopyPermissions(const FString& FilePath, const FString& TempFilePath)
+	{
+#if PLATFORM_WINDOWS
+		// There is no executable bit, the file attributes are kept by the rename
+		return true;
+#else
+		struct stat FileStat;
+		if (stat(TCHAR_TO_UTF8(*FilePath), &FileStat) != 0)
+		{
+			return false;
+		}
+		return chmod(TCHAR_TO_UTF8(*TempFilePath), FileStat.st_mode & 07777) == 0;
+#endif
+	}
+
+	/**
+	 * \brief Atomically replace the script with the temporary file, the script is either the old or the new one at any time
+	 * \param FilePath The script
+	 * \param TempFilePath The file to replace it with
+	 * \return False if the script was not replaced
+	 */
+	bool ReplaceFile(const FString& FilePath, const FString& TempFilePath)
+	{
+#if PLATFORM_WINDOWS
+		return MoveFileExW(*TempFilePath, *FilePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return rename(TCHAR_TO_UTF8(*TempFilePath), TCHAR_TO_UTF8(*FilePath)) == 0;
+#endif
+	}
+}
+
+bool FOWIModSDKBlacklist::Load(const FString& InFilePath, const FString& BlacklistStart)
+{
+	FilePath = InFilePath;
+
+	FString Content;
+	if (FFileHelper::LoadFileToString(Content, *FilePath) == false)
+	{
+		return false;
+	}
+
+	return Parse(Content, BlacklistStart);
+}
+
+bool FOWIModSDKBlacklist::Parse(const FString& Content, const FString& BlacklistStart)
+{
+	Prefix.Reset();
+	Suffix.Reset();
+	Comments.Reset();
+	Entries.Reset();
+	SavedEntries.Reset();
+
+	const int32 Start = Content.Find(BlacklistStart, ESearchCase::CaseSensitive);
+	if (BlacklistStart.IsEmpty() || Start == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Split the array into its words the way bash does, a folder may contain anything but a quote
+	int32 Index = Start + BlacklistStart.Len();
+	while (Index < Content.Len() && Content[Index] != TEXT(')'))
+	{
+		const TCHAR Character = Content[Index];
+		if (FChar::IsWhitespace(Character))
+		{
+			++Index;
+		} else if (Character == TEXT('"') || Character == TEXT('\''))
+		{
+			const int32 End = Content.Find(FString::Chr(Character), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1);
+			if (End == INDEX_NONE)
+			{
+				return false;
+			}
+
+			Entries.Add(Content.Mid(Index + 1, End - Index - 1), Content.Mid(Index, End - Index + 1));
+			Index = End + 1;
+		} else if (Character == TEXT('#'))
+		{
+			int32 End = Content.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index);
+			End = End == INDEX_NONE ? Content.Len() : End;
+
+			Comments.Add(Content.Mid(Index, End - Index).TrimEnd());
+			Index = End;
+		} else
+		{
+			const int32 WordStart = Index;
+			while (Index < Content.Len() && FChar::IsWhitespace(Content[Index]) == false && Content[Index] != TEXT(')'))
+			{
+				++Index;
+			}
+
+			const FString Word = Content.Mid(WordStart, Index - WordStart);
+			Entries.Add(Word, Word);
+		}
+	}
+
+	if (Index >= Content.Len())
+	{
+		return false;
+	}
+
+	Prefix = Content.Left(Start + BlacklistStart.Len());
+	Suffix = Content.Mid(Index);
+	SavedEntries = Entries;
+	return true;
+}
+
+bool FOWIModSDKBlacklist::Save()
+{
+	if (IsChanged() == false)
+	{
+		return true;
+	}
+
+	// Write next to the script and swap it in, a failed write never touches the script itself
+	const FString FullFilePath = FPaths::ConvertRelativePathToFull(FilePath);
+	const FString TempFilePath = FullFilePath + TEXT(".tmp");
+	if (FFileHelper::SaveStringToFile(ToString(), *TempFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) == false)
+	{
+		return false;
+	}
+
+	// The rename is atomic, if it fails the script is still there unchanged and the temporary file can go
+	if (OWIModSDKBlacklist::CopyPermissions(FullFilePath, TempFilePath) == false || OWIModSDKBlacklist::ReplaceFile(FullFilePath, TempFilePath) == false)
+	{
+		IFileManager::Get().Delete(*TempFilePath);
+		return false;
+	}
+
+	SavedEntries = Entries;
+	return true;
+}
+
+FString FOWIModSDKBlacklist::ToString() const
+{
+	TArray<FString> SortedEntries;
+	Entries.GenerateKeyArray(SortedEntries);
+	SortedEntries.Sort([](const FString& A, const FString& B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	});
+
+	FString Content = Prefix;
+	for (const FString& Comment : Comments)
+	{
+		Content += TEXT("\n\t") + Comment;
+	}
+
+	for (const FString& Entry : SortedEntries)
+	{
+		Content += TEXT("\n\t") + Entries.FindChecked(Entry);
+	}
+
+	Content += TEXT("\n") + Suffix;
+	return Content;
+}
+
+void FOWIModSDKBlacklist::Add(const FString& Folder)
+{
+	if (Entries.Contains(Folder) == false)
+	{
+		Entries.Add(Folder, QuoteEntry(Folder));
+	}
+}
+
+void FOWIModSDKBlacklist::Remove(const FString& Folder)
+{
+	Entries.Remove(Folder);
+}
+
+bool FOWIModSDKBlacklist::Contains(const FString& Folder) const
+{
+	return Entries.Contains(Folder);
+}
+
+bool FOWIModSDKBlacklist::IsChanged() const
+{
+	if (Entries.Num() != SavedEntries.Num())
+	{
+		return true;
+	}
+
+	for (const TPair<FString, FString>& Entry : Entries)
+	{
+		if (SavedEntries.Contains(Entry.Key) == false)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FOWIModSDKBlacklist::Num() const
+{
+	return Entries.Num();
+}
+
+FString FOWIModSDKBlacklist::QuoteEntry(const FString& Folder)
+{
+	int32 Index;
+	if (Folder.FindChar(TEXT('$'), Index) || Folder.FindChar(TEXT('`'), Index) || Folder.FindChar(TEXT('\\'), Index))
+	{
+		return TEXT("'") + Folder + TEXT("'");
+	}
+	return TEXT("\"") + Folder + TEXT("\"");
+}
@@ -1,260 +1,711 @@
-﻿// Copyright Offworld Industries
-
-#include "OWI_NamingConventionHandler.h"
-#include "Engine/Blueprint.h"
-#include "Materials/Material.h"
-#include "Materials/MaterialInstance.h"
-#include "Engine/SkeletalMesh.h"
-#include "Engine/EngineTypes.h"
-
-bool UOWINamingConventionHandler::NamingConventionCanBeApplied(UObject* Asset)
-{
-    Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	
-    if (Asset == nullptr || Settings == nullptr || Settings->bEnabled == false)
-    {
-        return false;
-    }
-
-	bool IsWhitelisted = false;
-
-	// Check if Asset is in a folder that should be checked
-	for (const FDirectoryPath FolderName : Settings->FolderWhitelist)
-	{
-		if (Asset->GetPathName().StartsWith(FolderName.Path))
-		{
-			IsWhitelisted = true;
-			break;
-		}
-	}
-
-	if (IsWhitelisted == false)
-	{
-		return false;
-	}
-
-    // Check if Asset is in a folder that shouldn't be checked
-    for (const FDirectoryPath FolderName : Settings->FolderBlacklist)
-    {
-        if (Asset->GetPathName().StartsWith(FolderName.Path))
-        {
-            return false;
-        }
-    }
-
-    return GetUObjectPrefixSuffix(Asset) != nullptr;
-}
-
-bool UOWINamingConventionHandler::NamingConventionIsViolated(UObject* Asset, FString& ValidationError)
-{
-	if (NamingConventionCanBeApplied(Asset) == false)
-	{
-		return false;
-	}
-    
-    bool bResult = false;
-    
-    FOWIPrefixSuffix* PrefixSuffix = GetUObjectPrefixSuffix(Asset);
-	
-    if (PrefixSuffix != nullptr)
-    {
-		const FString Name{ Asset->GetName() };
-        if (PrefixSuffix->Prefix.IsEmpty() == false && Name.StartsWith(*PrefixSuffix->Prefix) == false)
-        {
-            ValidationError = Name + " doesn't start with " + *PrefixSuffix->Prefix;
-            bResult = true;
-        }
-        
-        if (PrefixSuffix->OptionalSuffix.IsEmpty() == false && Name.EndsWith(*PrefixSuffix->OptionalSuffix) == false)
-        {
-            ValidationError.Append(bResult ? FString(" and ") : Name).Append(" doesn't end with ").Append(*PrefixSuffix->OptionalSuffix);
-            bResult = true;
-        }
-    }
-
-    return bResult;
-}
-
-void UOWINamingConventionHandler::RenameAsset(UObject* Asset)
-{
-    if (Asset == nullptr)
-    {
-        return;
-    }
-	
-    FOWIPrefixSuffix* PrefixSuffix = GetUObjectPrefixSuffix(Asset);
-	
-    if (PrefixSuffix != nullptr)
-    {
-        const FString Name{ Asset->GetName() };
-        FString NewName = Name;
-        if (Name.StartsWith(*PrefixSuffix->Prefix) == false)
-        {
-            NewName = *PrefixSuffix->Prefix + NewName;
-        }
-        
-        if (PrefixSuffix->OptionalSuffix.IsEmpty() == false && Name.EndsWith(*PrefixSuffix->OptionalSuffix) == false)
-        {
-            NewName = NewName + *PrefixSuffix->OptionalSuffix;
-        }
-
-        if (NewName.Equals(Name) == false)
-        {
-        	Asset->Rename(*NewName, Asset->GetOuter(), REN_DontCreateRedirectors);
-        }
-    }
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::GetUObjectPrefixSuffix(UObject* Object)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (Object == nullptr || Settings == nullptr)
-	{
-		return nullptr;
-	}
-
-	FOWIPrefixSuffix* PrefixSuffix = CheckMaterialInstanceTypes(Cast<UMaterialInstance>(Object));
-
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = CheckMaterialTypes(Cast<UMaterial>(Object));
-	}
-	
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = CheckSkeletalMeshTypes(Cast<USkeletalMesh>(Object));
-	}
-
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = CheckBlueprintTypes(Cast<UBlueprint>(Object));
-	}
-	
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = Settings->UObjectPrefixMap.Find(Object);
-	}
-	
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = GetUClassPrefixSuffix(Object->GetClass());
-	}
-
-	return PrefixSuffix;
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::GetUClassPrefixSuffix(const UClass* ObjectClass)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (ObjectClass == nullptr || Settings == nullptr)
-	{
-		// We reached the end of the chain
-		return nullptr;
-	}
-
-	FOWIPrefixSuffix* PrefixSuffix = Settings->UClassPrefixMap.Find(ObjectClass);
-
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = GetGenericPrefixSuffix(ObjectClass->GetDisplayNameText().ToString());
-	}
-
-	return PrefixSuffix == nullptr ? GetUClassPrefixSuffix(ObjectClass->GetSuperClass()) : PrefixSuffix;
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::GetGenericPrefixSuffix(const FString& ClassName)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-
-	return Settings == nullptr ? nullptr : Settings->GenericPrefixMap.Find(ClassName);
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::CheckBlueprintTypes(const UBlueprint* Blueprint)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (Blueprint == nullptr || Settings == nullptr)
-	{
-		return nullptr;
-	}
-
-	FOWIPrefixSuffix* PrefixSuffix = Settings->EBlueprintTypePrefixMap.Find(Blueprint->BlueprintType);
-
-	if (PrefixSuffix == nullptr)
-	{
-		for (TPair<UObject*, FOWIPrefixSuffix>& Pair : Settings->UObjectPrefixMap)
-		{
-			if (Blueprint->ParentClass && Pair.Key && Blueprint->ParentClass->GetName().Equals(Pair.Key->GetName()))
-			{
-				PrefixSuffix = &Pair.Value;
-				break;
-			}
-		}
-	}
-
-	if (PrefixSuffix == nullptr)
-	{
-		PrefixSuffix = GetGenericPrefixSuffix(Blueprint->ParentClass->GetName());
-	}
-
-	return PrefixSuffix;
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::CheckMaterialTypes(const UMaterial* Material)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (Material == nullptr || Settings == nullptr)
-	{
-		return nullptr;
-	}
-
-	return Material->IsPostProcessMaterial() ? &Settings->Material_WithPostProcessing : &Settings->Material_WithoutPostProcessing;
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::CheckMaterialInstanceTypes(UMaterialInstance* MaterialInstance)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (MaterialInstance == nullptr || Settings == nullptr)
-	{
-		return nullptr;
-	}
-
-	return MaterialInstance->GetBaseMaterial()->IsPostProcessMaterial() ? &Settings->MaterialInstance_WithPostProcessing : &Settings->MaterialInstance_WithoutPostProcessing;
-}
-
-FOWIPrefixSuffix* UOWINamingConventionHandler::CheckSkeletalMeshTypes(USkeletalMesh* SkeletalMeshInstance)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
-	}
-	
-	if (SkeletalMeshInstance == nullptr || Settings == nullptr)
-	{
-		return nullptr;
-	}
-
-	return SkeletalMeshInstance->MorphTargets.Num() > 0 ? &Settings->SkeletalMesh_WithMorphTargets : &Settings->SkeletalMesh_WithoutMorphTargets;
-}
+﻿// Copyright Offworld Industries
+
+#include "OWI_NamingConventionHandler.h"
+#include "AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Engine/Blueprint.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/EngineTypes.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/UObjectIterator.h"
+#include "OWI_ValidationStats.h"
+
+DEFINE_LOG_CATEGORY(LogOWINamingConventions);
+
+const FName UOWINamingConventionHandler::PostProcessMaterialTag = TEXT("OWI_PostProcessMaterial");
+
+#if WITH_EDITOR
+void UOWINamingConventionHandlerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateCompiledSettings();
+}
+#endif
+
+void UOWINamingConventionHandlerSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	InvalidateCompiledSettings();
+}
+
+bool UOWINamingConventionHandlerSettings::FindResolvedClass(const UClass* ObjectClass, FOWIPrefixSuffix*& OutPrefixSuffix) const
+{
+	FOWIPrefixSuffix* const* ResolvedPrefixSuffix = ResolvedClasses.Find(ObjectClass);
+	if (ResolvedPrefixSuffix == nullptr)
+	{
+		return false;
+	}
+
+	OutPrefixSuffix = *ResolvedPrefixSuffix;
+	return true;
+}
+
+void UOWINamingConventionHandlerSettings::AddResolvedClass(const UClass* ObjectClass, FOWIPrefixSuffix* PrefixSuffix)
+{
+	ResolvedClasses.Add(ObjectClass, PrefixSuffix);
+}
+
+bool UOWINamingConventionHandlerSettings::FindResolvedMaterial(const FName MaterialPath, bool& bOutPostProcess) const
+{
+	const bool* ResolvedPostProcess = ResolvedMaterials.Find(MaterialPath);
+	if (ResolvedPostProcess == nullptr)
+	{
+		return false;
+	}
+
+	bOutPostProcess = *ResolvedPostProcess;
+	return true;
+}
+
+void UOWINamingConventionHandlerSettings::AddResolvedMaterial(const FName MaterialPath, const FName ParentPath, const bool bPostProcess)
+{
+	ResolvedMaterials.Add(MaterialPath, bPostProcess);
+	if (ParentPath.IsNone() == false)
+	{
+		ResolvedMaterialChildren.AddUnique(ParentPath, MaterialPath);
+	}
+}
+
+void UOWINamingConventionHandlerSettings::InvalidateResolvedMaterial(const FName MaterialPath)
+{
+	// Only the materials below the changed one may have a different base material now, all others stay resolved
+	TArray<FName, TInlineAllocator<16>> PendingPaths;
+	PendingPaths.Add(MaterialPath);
+	while (PendingPaths.Num() > 0)
+	{
+		const FName PendingPath = PendingPaths.Pop(false);
+		ResolvedMaterials.Remove(PendingPath);
+
+		TArray<FName, TInlineAllocator<16>> Children;
+		ResolvedMaterialChildren.MultiFind(PendingPath, Children);
+		ResolvedMaterialChildren.Remove(PendingPath);
+		PendingPaths.Append(Children);
+	}
+}
+
+void UOWINamingConventionHandlerSettings::InvalidateCaches()
+{
+	ResolvedClasses.Reset();
+}
+
+void UOWINamingConventionHandlerSettings::RemoveStaleClasses()
+{
+	for (auto It = ResolvedClasses.CreateIterator(); It; ++It)
+	{
+		if (It.Key().IsValid() == false)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UOWINamingConventionHandlerSettings::InvalidateCompiledSettings()
+{
+	// The resolved PrefixSuffix pointers point into the maps that just changed
+	InvalidateCaches();
+	bFolderFilterCompiled = false;
+	bGenericPrefixMapCompiled = false;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandlerSettings::FindGenericPrefixSuffix(const UClass* ObjectClass)
+{
+	if (bGenericPrefixMapCompiled == false)
+	{
+		CompileGenericPrefixMap();
+	}
+
+	if (FOWIPrefixSuffix** PrefixSuffix = GenericClasses.Find(TWeakObjectPtr<const UClass>(ObjectClass)))
+	{
+		return *PrefixSuffix;
+	}
+
+	// Classes loaded or reinstanced after compiling are resolved on first use
+	const FName DisplayName(*ObjectClass->GetDisplayNameText().ToString(), FNAME_Find);
+	FOWIPrefixSuffix* PrefixSuffix = DisplayName.IsNone() ? nullptr : GenericNames.FindRef(DisplayName);
+	GenericClasses.Add(TWeakObjectPtr<const UClass>(ObjectClass), PrefixSuffix);
+	return PrefixSuffix;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandlerSettings::FindGenericPrefixSuffix(const FName ClassName)
+{
+	if (bGenericPrefixMapCompiled == false)
+	{
+		CompileGenericPrefixMap();
+	}
+
+	return GenericNames.FindRef(ClassName);
+}
+
+void UOWINamingConventionHandlerSettings::CompileGenericPrefixMap()
+{
+	GenericNames.Reset();
+	GenericClasses.Reset();
+	for (TPair<FString, FOWIPrefixSuffix>& Pair : GenericPrefixMap)
+	{
+		GenericNames.Add(FName(*Pair.Key), &Pair.Value);
+	}
+
+	// Display names are looked up once per class here instead of once per class and Asset
+	TSet<FName> UsedNames;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		// A display name that isn't in the name table can't be a key of the map
+		const FName DisplayName(*It->GetDisplayNameText().ToString(), FNAME_Find);
+		FOWIPrefixSuffix* PrefixSuffix = DisplayName.IsNone() ? nullptr : GenericNames.FindRef(DisplayName);
+		GenericClasses.Add(TWeakObjectPtr<const UClass>(*It), PrefixSuffix);
+
+		if (PrefixSuffix != nullptr)
+		{
+			UsedNames.Add(DisplayName);
+		}
+
+		// Blueprints look up their parent class by its plain name
+		if (GenericNames.Contains(It->GetFName()))
+		{
+			UsedNames.Add(It->GetFName());
+		}
+	}
+
+	for (const TPair<FName, FOWIPrefixSuffix*>& Pair : GenericNames)
+	{
+		if (UsedNames.Contains(Pair.Key) == false)
+		{
+			UE_LOG(LogOWINamingConventions, Warning, TEXT("Generic Prefix Map entry \"%s\" doesn't match any loaded class!"), *Pair.Key.ToString());
+		}
+	}
+
+	bGenericPrefixMapCompiled = true;
+}
+
+bool UOWINamingConventionHandlerSettings::IsInCheckedFolder(const FString& AssetPath) const
+{
+	enum EFolderTag : int32
+	{
+		Whitelist,
+		Blacklist
+	};
+
+	if (bFolderFilterCompiled == false)
+	{
+		FolderFilter.Reset();
+		for (const FDirectoryPath& Folder : FolderWhitelist)
+		{
+			FolderFilter.Insert(Folder.Path, Whitelist);
+		}
+		for (const FDirectoryPath& Folder : FolderBlacklist)
+		{
+			FolderFilter.Insert(Folder.Path, Blacklist);
+		}
+		bFolderFilterCompiled = true;
+	}
+
+	bool bWhitelisted = false;
+	bool bBlacklisted = false;
+	FolderFilter.ForEachPrefixTag(AssetPath, [&bWhitelisted, &bBlacklisted](const int32 Tag)
+	{
+		(Tag == Whitelist ? bWhitelisted : bBlacklisted) = true;
+	});
+
+	return bWhitelisted && bBlacklisted == false;
+}
+
+bool UOWINamingConventionHandler::NamingConventionCanBeApplied(UObject* Asset)
+{
+    Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	
+    if (Asset == nullptr || Settings == nullptr || Settings->bEnabled == false)
+    {
+        return false;
+    }
+
+	// Check if Asset is in a folder that should be checked and not in one that shouldn't be checked
+	if (Settings->IsInCheckedFolder(Asset->GetPathName()) == false)
+	{
+		return false;
+	}
+
+    return GetUObjectPrefixSuffix(Asset) != nullptr;
+}
+
+bool UOWINamingConventionHandler::NamingConventionIsViolated(UObject* Asset, FString& ValidationError)
+{
+	OWI_VALIDATION_SCOPE(NamingConventions);
+
+	if (NamingConventionCanBeApplied(Asset) == false)
+	{
+		return false;
+	}
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::NamingConventionsChecked);
+    
+    FOWIPrefixSuffix* PrefixSuffix = GetUObjectPrefixSuffix(Asset);
+	
+    return PrefixSuffix != nullptr && IsNameViolated(Asset->GetName(), *PrefixSuffix, ValidationError);
+}
+
+bool UOWINamingConventionHandler::NamingConventionIsViolated(const FAssetData& AssetData, FString& ValidationError)
+{
+    OWI_VALIDATION_SCOPE(NamingConventions);
+
+    Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+
+    if (AssetData.IsValid() == false || AssetData.IsRedirector() || Settings == nullptr || Settings->bEnabled == false
+        || Settings->IsInCheckedFolder(AssetData.ObjectPath.ToString()) == false)
+    {
+        return false;
+    }
+    FOWIValidationStats::Get().Add(EOWIValidationCounter::NamingConventionsChecked);
+
+    bool bNeedsLoading = false;
+    FOWIPrefixSuffix* PrefixSuffix = GetAssetDataPrefixSuffix(AssetData, bNeedsLoading);
+    if (bNeedsLoading)
+    {
+        // The folders were already checked, only the object itself is missing
+        UObject* Asset = AssetData.GetAsset();
+        PrefixSuffix = Asset == nullptr ? nullptr : GetUObjectPrefixSuffix(Asset);
+    }
+
+    return PrefixSuffix != nullptr && IsNameViolated(AssetData.AssetName.ToString(), *PrefixSuffix, ValidationError);
+}
+
+bool UOWINamingConventionHandler::IsNameViolated(const FString& Name, const FOWIPrefixSuffix& PrefixSuffix, FString& ValidationError)
+{
+    bool bResult = false;
+
+    if (PrefixSuffix.Prefix.IsEmpty() == false && Name.StartsWith(*PrefixSuffix.Prefix) == false)
+    {
+        ValidationError = Name + " doesn't start with " + *PrefixSuffix.Prefix;
+        bResult = true;
+    }
+
+    if (PrefixSuffix.OptionalSuffix.IsEmpty() == false && Name.EndsWith(*PrefixSuffix.OptionalSuffix) == false)
+    {
+        ValidationError.Append(bResult ? FString(" and ") : Name).Append(" doesn't end with ").Append(*PrefixSuffix.OptionalSuffix);
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+void UOWINamingConventionHandler::RenameAsset(UObject* Asset)
+{
+    if (Asset == nullptr)
+    {
+        return;
+    }
+
+    RenameAssets({ Asset });
+}
+
+int32 UOWINamingConventionHandler::RenameAssets(const TArray<UObject*>& Assets)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	// Compute all new names first so collisions are found before anything gets renamed
+	TArray<FAssetRenameData> RenameData;
+	TArray<FString> OldObjectPaths;
+	TSet<FName> NewObjectPaths;
+	for (UObject* Asset : Assets)
+	{
+		FString NewName;
+		if (Asset == nullptr || GetConventionalName(Asset, NewName) == false)
+		{
+			continue;
+		}
+
+		const FString PackagePath = FPackageName::GetLongPackagePath(Asset->GetOutermost()->GetName());
+		const FName NewObjectPath(*FString::Printf(TEXT("%s/%s.%s"), *PackagePath, *NewName, *NewName));
+
+		bool bAlreadyInBatch = false;
+		NewObjectPaths.Add(NewObjectPath, &bAlreadyInBatch);
+		if (bAlreadyInBatch || AssetRegistry.GetAssetByObjectPath(NewObjectPath).IsValid())
+		{
+			UE_LOG(LogOWINamingConventions, Warning, TEXT("Could not rename %s, %s already exists!"), *Asset->GetPathName(), *NewObjectPath.ToString());
+			continue;
+		}
+
+		OldObjectPaths.Add(Asset->GetPathName());
+		RenameData.Emplace(Asset, PackagePath, NewName);
+	}
+
+	if (RenameData.Num() == 0)
+	{
+		return 0;
+	}
+
+	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools")).Get();
+	if (AssetTools.RenameAssets(RenameData) == false)
+	{
+		UE_LOG(LogOWINamingConventions, Error, TEXT("Could not rename all of the %d Assets!"), RenameData.Num());
+	}
+
+	// Unloaded referencers still point to the old names, resolve all redirectors in a single pass
+	TArray<UObjectRedirector*> Redirectors;
+	int32 NumRenamed = 0;
+	for (int32 RenameIndex = 0; RenameIndex < RenameData.Num(); ++RenameIndex)
+	{
+		const UObject* Asset = RenameData[RenameIndex].Asset.Get();
+		if (Asset == nullptr || Asset->GetName() != RenameData[RenameIndex].NewName)
+		{
+			continue;
+		}
+
+		++NumRenamed;
+		if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *OldObjectPaths[RenameIndex]))
+		{
+			Redirectors.Add(Redirector);
+		}
+	}
+
+	if (Redirectors.Num() > 0)
+	{
+		AssetTools.FixupReferencers(Redirectors);
+	}
+
+	return NumRenamed;
+}
+
+bool UOWINamingConventionHandler::GetConventionalName(UObject* Asset, FString& OutNewName)
+{
+    FOWIPrefixSuffix* PrefixSuffix = GetUObjectPrefixSuffix(Asset);
+    if (PrefixSuffix == nullptr)
+    {
+        return false;
+    }
+
+    const FString Name{ Asset->GetName() };
+    OutNewName = Name;
+    if (Name.StartsWith(*PrefixSuffix->Prefix) == false)
+    {
+        OutNewName = *PrefixSuffix->Prefix + OutNewName;
+    }
+
+    if (PrefixSuffix->OptionalSuffix.IsEmpty() == false && Name.EndsWith(*PrefixSuffix->OptionalSuffix) == false)
+    {
+        OutNewName = OutNewName + *PrefixSuffix->OptionalSuffix;
+    }
+
+    return OutNewName.Equals(Name) == false;
+}
+
+bool UOWINamingConventionHandler::IsPostProcessMaterial(const UMaterialInterface* Material)
+{
+	UOWINamingConventionHandlerSettings* MutableSettings = GetMutableDefault<UOWINamingConventionHandlerSettings>();
+
+	// Walk up the parents until a resolved one or the base material is reached
+	TArray<FName, TInlineAllocator<8>> VisitedPaths;
+	FName StopPath;
+	bool bPostProcess = false;
+	for (const UMaterialInterface* Current = Material; Current != nullptr;)
+	{
+		const FName CurrentPath(*Current->GetPathName());
+		if (MutableSettings->FindResolvedMaterial(CurrentPath, bPostProcess))
+		{
+			StopPath = CurrentPath;
+			break;
+		}
+		VisitedPaths.Add(CurrentPath);
+
+		if (const UMaterial* BaseMaterial = Cast<UMaterial>(Current))
+		{
+			bPostProcess = BaseMaterial->IsPostProcessMaterial();
+			break;
+		}
+
+		const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(Current);
+		Current = MaterialInstance == nullptr ? nullptr : MaterialInstance->Parent;
+	}
+
+	// Every material on the way shares the same base material, each one is remembered with the parent it was resolved
+	// through so saving a material only drops the materials below it
+	for (int32 VisitedIndex = 0; VisitedIndex < VisitedPaths.Num(); ++VisitedIndex)
+	{
+		const FName ParentPath = VisitedIndex + 1 < VisitedPaths.Num() ? VisitedPaths[VisitedIndex + 1] : StopPath;
+		MutableSettings->AddResolvedMaterial(VisitedPaths[VisitedIndex], ParentPath, bPostProcess);
+	}
+
+	return bPostProcess;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::GetUObjectPrefixSuffix(UObject* Object)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (Object == nullptr || Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	FOWIPrefixSuffix* PrefixSuffix = CheckMaterialInstanceTypes(Cast<UMaterialInstance>(Object));
+
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = CheckMaterialTypes(Cast<UMaterial>(Object));
+	}
+	
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = CheckSkeletalMeshTypes(Cast<USkeletalMesh>(Object));
+	}
+
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = CheckBlueprintTypes(Cast<UBlueprint>(Object));
+	}
+	
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = Settings->UObjectPrefixMap.Find(Object);
+	}
+	
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = GetUClassPrefixSuffix(Object->GetClass());
+	}
+
+	return PrefixSuffix;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::GetAssetDataPrefixSuffix(const FAssetData& AssetData, bool& bOutNeedsLoading)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+
+	bOutNeedsLoading = false;
+	if (Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	const UClass* AssetClass = FindObject<UClass>(ANY_PACKAGE, *AssetData.AssetClass.ToString());
+
+	// Materials saved with this plugin carry their post processing classification
+	FString PostProcessMaterial;
+	if (AssetClass != nullptr && AssetData.GetTagValue(PostProcessMaterialTag, PostProcessMaterial))
+	{
+		const bool bPostProcess = PostProcessMaterial.ToBool();
+		if (AssetClass->IsChildOf(UMaterial::StaticClass()))
+		{
+			return bPostProcess ? &Settings->Material_WithPostProcessing : &Settings->Material_WithoutPostProcessing;
+		}
+
+		if (AssetClass->IsChildOf(UMaterialInstance::StaticClass()))
+		{
+			return bPostProcess ? &Settings->MaterialInstance_WithPostProcessing : &Settings->MaterialInstance_WithoutPostProcessing;
+		}
+	}
+
+	// Post Processing and Morph Targets are otherwise only known to the loaded object
+	if (AssetClass == nullptr
+		|| AssetClass->IsChildOf(UMaterialInterface::StaticClass())
+		|| AssetClass->IsChildOf(USkeletalMesh::StaticClass()))
+	{
+		bOutNeedsLoading = true;
+		return nullptr;
+	}
+
+	FOWIPrefixSuffix* PrefixSuffix = nullptr;
+	if (AssetClass->IsChildOf(UBlueprint::StaticClass()))
+	{
+		PrefixSuffix = CheckBlueprintTypes(AssetData);
+	}
+
+	// Objects referenced by the settings are always loaded, so an unloaded Asset can't be in the map
+	if (PrefixSuffix == nullptr)
+	{
+		UObject* LoadedAsset = AssetData.FastGetAsset(false);
+		PrefixSuffix = LoadedAsset == nullptr ? nullptr : Settings->UObjectPrefixMap.Find(LoadedAsset);
+	}
+
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = GetUClassPrefixSuffix(AssetClass);
+	}
+
+	return PrefixSuffix;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::GetUClassPrefixSuffix(const UClass* ObjectClass)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (ObjectClass == nullptr || Settings == nullptr)
+	{
+		// We reached the end of the chain
+		return nullptr;
+	}
+
+	FOWIPrefixSuffix* PrefixSuffix = nullptr;
+	if (Settings->FindResolvedClass(ObjectClass, PrefixSuffix))
+	{
+		FOWIValidationStats::Get().Add(EOWIValidationCounter::ClassCacheHits);
+		return PrefixSuffix;
+	}
+
+	TArray<const UClass*, TInlineAllocator<16>> WalkedClasses;
+	for (const UClass* CurrentClass = ObjectClass; CurrentClass != nullptr; CurrentClass = CurrentClass->GetSuperClass())
+	{
+		// A parent class might already have been resolved through one of its other children
+		if (CurrentClass != ObjectClass && Settings->FindResolvedClass(CurrentClass, PrefixSuffix))
+		{
+			break;
+		}
+		WalkedClasses.Add(CurrentClass);
+
+		PrefixSuffix = Settings->UClassPrefixMap.Find(CurrentClass);
+
+		if (PrefixSuffix == nullptr)
+		{
+			PrefixSuffix = Settings->FindGenericPrefixSuffix(CurrentClass);
+		}
+
+		if (PrefixSuffix != nullptr)
+		{
+			break;
+		}
+	}
+
+	// Every class on the way up to the matching one resolves to the same PrefixSuffix, so their other children can stop there
+	for (const UClass* WalkedClass : WalkedClasses)
+	{
+		Settings->AddResolvedClass(WalkedClass, PrefixSuffix);
+	}
+	return PrefixSuffix;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::GetGenericPrefixSuffix(const FName ClassName)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+
+	return Settings == nullptr ? nullptr : Settings->FindGenericPrefixSuffix(ClassName);
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::CheckBlueprintTypes(const UBlueprint* Blueprint)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (Blueprint == nullptr || Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	FOWIPrefixSuffix* PrefixSuffix = Settings->EBlueprintTypePrefixMap.Find(Blueprint->BlueprintType);
+
+	if (PrefixSuffix == nullptr)
+	{
+		for (TPair<UObject*, FOWIPrefixSuffix>& Pair : Settings->UObjectPrefixMap)
+		{
+			if (Blueprint->ParentClass && Pair.Key && Blueprint->ParentClass->GetName().Equals(Pair.Key->GetName()))
+			{
+				PrefixSuffix = &Pair.Value;
+				break;
+			}
+		}
+	}
+
+	if (PrefixSuffix == nullptr)
+	{
+		PrefixSuffix = Blueprint->ParentClass == nullptr ? nullptr : GetGenericPrefixSuffix(Blueprint->ParentClass->GetFName());
+	}
+
+	return PrefixSuffix;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::CheckBlueprintTypes(const FAssetData& AssetData)
+{
+	FOWIPrefixSuffix* PrefixSuffix = nullptr;
+
+	FString BlueprintType;
+	if (AssetData.GetTagValue(FBlueprintTags::BlueprintType, BlueprintType))
+	{
+		const int64 BlueprintTypeValue = StaticEnum<EBlueprintType>()->GetValueByNameString(BlueprintType);
+		if (BlueprintTypeValue != INDEX_NONE)
+		{
+			PrefixSuffix = Settings->EBlueprintTypePrefixMap.Find(static_cast<EBlueprintType>(BlueprintTypeValue));
+		}
+	}
+
+	if (PrefixSuffix != nullptr)
+	{
+		return PrefixSuffix;
+	}
+
+	// The tag holds the path of the parent class, only its name is compared
+	FString ParentClassPath;
+	if (AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath) == false)
+	{
+		return nullptr;
+	}
+	const FString ParentClassName = FPackageName::ObjectPathToObjectName(FPackageName::ExportTextPathToObjectPath(ParentClassPath));
+
+	for (TPair<UObject*, FOWIPrefixSuffix>& Pair : Settings->UObjectPrefixMap)
+	{
+		if (Pair.Key && ParentClassName.Equals(Pair.Key->GetName()))
+		{
+			return &Pair.Value;
+		}
+	}
+
+	return GetGenericPrefixSuffix(FName(*ParentClassName, FNAME_Find));
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::CheckMaterialTypes(const UMaterial* Material)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (Material == nullptr || Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	return Material->IsPostProcessMaterial() ? &Settings->Material_WithPostProcessing : &Settings->Material_WithoutPostProcessing;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::CheckMaterialInstanceTypes(UMaterialInstance* MaterialInstance)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (MaterialInstance == nullptr || Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	return IsPostProcessMaterial(MaterialInstance) ? &Settings->MaterialInstance_WithPostProcessing : &Settings->MaterialInstance_WithoutPostProcessing;
+}
+
+FOWIPrefixSuffix* UOWINamingConventionHandler::CheckSkeletalMeshTypes(USkeletalMesh* SkeletalMeshInstance)
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWINamingConventionHandlerSettings*>(GetDefault<UOWINamingConventionHandlerSettings>());
+	}
+	
+	if (SkeletalMeshInstance == nullptr || Settings == nullptr)
+	{
+		return nullptr;
+	}
+
+	return SkeletalMeshInstance->MorphTargets.Num() > 0 ? &Settings->SkeletalMesh_WithMorphTargets : &Settings->SkeletalMesh_WithoutMorphTargets;
+}
@@ -0,0 +1,78 @@
+// Copyright Offworld Industries
+
+#include "OWI_PackageChangeListener.h"
+#include "AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+
+FOWIPackageChangeListener::~FOWIPackageChangeListener()
+{
+	Stop();
+}
+
+void FOWIPackageChangeListener::Start(FOnPackageChanged InOnPackageChanged, const bool bIncludeAdded)
+{
+	Stop();
+	OnPackageChanged = MoveTemp(InOnPackageChanged);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	if (bIncludeAdded)
+	{
+		AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FOWIPackageChangeListener::OnAssetChanged);
+	}
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FOWIPackageChangeListener::OnAssetChanged);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FOWIPackageChangeListener::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FOWIPackageChangeListener::OnAssetChanged);
+}
+
+void FOWIPackageChangeListener::Stop()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(AssetRegistryConstants::ModuleName))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	OnPackageChanged = nullptr;
+}
+
+FGuid FOWIPackageChangeListener::GetPackageGuid(const FName PackageName, const IAssetRegistry& AssetRegistry)
+{
+	const FAssetPackageData* PackageData = AssetRegistry.GetAssetPackageData(PackageName);
+	return PackageData == nullptr ? FGuid() : PackageData->PackageGuid;
+}
+
+FGuid FOWIPackageChangeListener::GetPackageGuid(const FName PackageName)
+{
+	return GetPackageGuid(PackageName, FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get());
+}
+
+bool FOWIPackageChangeListener::IsInitialScanRunning()
+{
+	return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get().IsLoadingAssets();
+}
+
+void FOWIPackageChangeListener::OnAssetChanged(const FAssetData& AssetData)
+{
+	if (OnPackageChanged.IsSet() && IsInitialScanRunning() == false)
+	{
+		OnPackageChanged(AssetData.PackageName);
+	}
+}
+
+void FOWIPackageChangeListener::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (OnPackageChanged.IsSet() == false || IsInitialScanRunning())
+	{
+		return;
+	}
+
+	OnPackageChanged(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+	OnPackageChanged(AssetData.PackageName);
+}
@@ -0,0 +1,94 @@
+// Copyright Offworld Industries
+
+#include "OWI_PathTrie.h"
+
+FOWIPathTrie::FOWIPathTrie()
+{
+	Reset();
+}
+
+void FOWIPathTrie::Reset()
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+}
+
+void FOWIPathTrie::Insert(const FString& Path, const int32 Tag)
+{
+	Nodes[FindOrAddNode(Path)].Tags.AddUnique(Tag);
+}
+
+int32 FOWIPathTrie::FindOrAddNode(const FString& Path)
+{
+	int32 NodeIndex = 0;
+	ForEachSegment(*Path, Path.Len(), [this, &NodeIndex](const TCHAR* Segment, const int32 SegmentLen)
+	{
+		const FName SegmentName(SegmentLen, Segment);
+		const int32* ChildIndex = Nodes[NodeIndex].Children.Find(SegmentName);
+		if (ChildIndex == nullptr)
+		{
+			// Adding may reallocate Nodes, so don't keep a reference to the parent around
+			const int32 NewIndex = Nodes.AddDefaulted();
+			Nodes[NewIndex].Parent = NodeIndex;
+			Nodes[NodeIndex].Children.Add(SegmentName, NewIndex);
+			NodeIndex = NewIndex;
+		} else
+		{
+			NodeIndex = *ChildIndex;
+		}
+		return true;
+	});
+
+	return NodeIndex;
+}
+
+int32 FOWIPathTrie::FindNode(const FString& Path) const
+{
+	int32 LastNode = 0;
+	const bool bFound = ForEachNodeOnPath(*Path, Path.Len(), [&LastNode](const int32 NodeIndex)
+	{
+		LastNode = NodeIndex;
+	});
+
+	return bFound ? LastNode : INDEX_NONE;
+}
+
+int32 FOWIPathTrie::NumNodes() const
+{
+	return Nodes.Num();
+}
+
+bool FOWIPathTrie::IsEmpty() const
+{
+	for (const FNode& Node : Nodes)
+	{
+		if (Node.Tags.Num() > 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FOWIPathTrie::IsInFolder(const TCHAR* Path, const int32 Len, const FString& Folder)
+{
+	int32 FolderLen = Folder.Len();
+	while (FolderLen > 0 && Folder[FolderLen - 1] == TEXT('/'))
+	{
+		--FolderLen;
+	}
+
+	if (FolderLen == 0)
+	{
+		return true;
+	}
+
+	if (Len < FolderLen || FCString::Strnicmp(Path, *Folder, FolderLen) != 0)
+	{
+		return false;
+	}
+
+	// Only match whole segments, "/Game/Foo" is not inside "/Game/Fo"
+	return Len == FolderLen || Path[FolderLen] == TEXT('/') || Path[FolderLen] == TEXT('.') || Path[FolderLen] == TEXT(':');
+}
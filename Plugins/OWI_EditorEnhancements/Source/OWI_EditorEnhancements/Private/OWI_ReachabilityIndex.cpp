@@ -0,0 +1,145 @@
+// Copyright Offworld Industries
+
+#include "OWI_ReachabilityIndex.h"
+#include "Algo/Reverse.h"
+
+void FOWIReachabilityIndex::Reset(const int32 InNumBits)
+{
+	Components.Reset();
+	NodeWords.Reset();
+	ComponentWords.Reset();
+	NumBits = InNumBits;
+	WordsPerBitSet = FMath::DivideAndRoundUp(InNumBits, 32);
+}
+
+void FOWIReachabilityIndex::AddReachableBits(const FName PackageName, const FGetDependencies GetDependencies, const FClassifyPackage ClassifyPackage, TBitArray<>& InOutBits)
+{
+	if (NumBits == 0)
+	{
+		return;
+	}
+
+	const int32 Node = Components.FindOrAddNode(PackageName);
+	Components.Explore(Node, GetDependencies, [this, ClassifyPackage](const int32 VisitedNode)
+	{
+		ClassifyNode(VisitedNode, ClassifyPackage);
+	}, [this](const int32 Component, const TArray<int32>& Members)
+	{
+		FinishComponent(Component, Members);
+	});
+
+	const uint32* Words = &ComponentWords[Components.GetComponent(Node) * WordsPerBitSet];
+	for (int32 Bit = 0; Bit < NumBits; ++Bit)
+	{
+		if (HasBit(Words, Bit))
+		{
+			InOutBits[Bit] = true;
+		}
+	}
+}
+
+bool FOWIReachabilityIndex::FindPath(const TArray<FName>& StartPackages, const int32 Bit, TArray<FName>& OutPath) const
+{
+	OutPath.Reset();
+
+	// Breadth first search, only through components that reach the bit at all
+	TMap<int32, int32> Predecessors;
+	TArray<int32> Queue;
+	for (const FName& StartPackage : StartPackages)
+	{
+		const int32 Node = Components.FindNode(StartPackage);
+		if (Node != INDEX_NONE && Components.GetComponent(Node) != INDEX_NONE && Predecessors.Contains(Node) == false
+			&& HasBit(&ComponentWords[Components.GetComponent(Node) * WordsPerBitSet], Bit))
+		{
+			Predecessors.Add(Node, INDEX_NONE);
+			Queue.Add(Node);
+		}
+	}
+
+	int32 LastNode = INDEX_NONE;
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num() && LastNode == INDEX_NONE; ++QueueIndex)
+	{
+		const int32 Node = Queue[QueueIndex];
+		if (HasBit(&NodeWords[Node * WordsPerBitSet], Bit))
+		{
+			LastNode = Node;
+			break;
+		}
+
+		for (const int32 Dependency : Components.GetDependencies(Node))
+		{
+			if (Predecessors.Contains(Dependency) == false
+				&& HasBit(&ComponentWords[Components.GetComponent(Dependency) * WordsPerBitSet], Bit))
+			{
+				Predecessors.Add(Dependency, Node);
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	if (LastNode == INDEX_NONE)
+	{
+		return false;
+	}
+
+	for (int32 Node = LastNode; Node != INDEX_NONE; Node = Predecessors[Node])
+	{
+		OutPath.Add(Components.GetPackageName(Node));
+	}
+	Algo::Reverse(OutPath);
+	return true;
+}
+
+int32 FOWIReachabilityIndex::Num() const
+{
+	return Components.Num();
+}
+
+int32 FOWIReachabilityIndex::GetNumBits() const
+{
+	return NumBits;
+}
+
+void FOWIReachabilityIndex::ClassifyNode(const int32 Node, const FClassifyPackage ClassifyPackage)
+{
+	// Nodes are added while their referencers are visited, so the words are only sized once a node is visited itself
+	NodeWords.SetNumZeroed(Components.Num() * WordsPerBitSet);
+
+	TBitArray<> Bits(false, NumBits);
+	ClassifyPackage(Components.GetPackageName(Node), Bits);
+	uint32* Words = &NodeWords[Node * WordsPerBitSet];
+	for (TConstSetBitIterator<> It(Bits); It; ++It)
+	{
+		Words[It.GetIndex() / 32] |= 1u << (It.GetIndex() % 32);
+	}
+}
+
+void FOWIReachabilityIndex::FinishComponent(const int32 Component, const TArray<int32>& Members)
+{
+	// Components are finished in reverse topological order, so every dependency outside is complete already
+	ComponentWords.AddZeroed(WordsPerBitSet);
+	uint32* Words = &ComponentWords[Component * WordsPerBitSet];
+	for (const int32 Member : Members)
+	{
+		const uint32* MemberWords = &NodeWords[Member * WordsPerBitSet];
+		for (int32 WordIndex = 0; WordIndex < WordsPerBitSet; ++WordIndex)
+		{
+			Words[WordIndex] |= MemberWords[WordIndex];
+		}
+
+		for (const int32 Dependency : Components.GetDependencies(Member))
+		{
+			const int32 DependencyComponent = Components.GetComponent(Dependency);
+			if (DependencyComponent == Component)
+			{
+				continue;
+			}
+
+			const uint32* DependencyWords = &ComponentWords[DependencyComponent * WordsPerBitSet];
+			for (int32 WordIndex = 0; WordIndex < WordsPerBitSet; ++WordIndex)
+			{
+				Words[WordIndex] |= DependencyWords[WordIndex];
+			}
+		}
+	}
+}
@@ -1,187 +1,580 @@
-// Copyright Offworld Industries
-
-#include "OWI_ReferenceRulesHandler.h"
-#include "Runtime/AssetRegistry/Public/AssetRegistryModule.h"
-#include "Runtime/AssetRegistry/Public/IAssetRegistry.h"
-
-bool FOWIReferenceRule::IsViolated(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError) const
-{
-	for (const FName& Reference : References)
-	{
-		if (Reference.ToString().StartsWith(MayNotReferenceFolder.Path)
-			&& AssetPath.StartsWith(MayNotReferenceFolder.Path) == false
-			&& IsException(Reference) == false)
-		{
-			ValidationError = AssetPath + " references " + Reference.ToString() + " in invalid folder " + MayNotReferenceFolder.Path;
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool FOWIReferenceRule::CanBeApplied(const FString& AssetPath) const
-{
-	return AssetPath.StartsWith(AssetFolder.Path);
-}
-
-bool FOWIReferenceRule::IsException(const FName& Reference) const
-{
-	for (const FDirectoryPath& ExceptionFolder : ExceptionFolders)
-	{
-		if (Reference.ToString().StartsWith(ExceptionFolder.Path))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool UOWIReferenceRulesHandler::RuleIsViolated(const FString& AssetPath, FString& ValidationError)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWIReferenceRulesHandlerSettings*>(GetDefault<UOWIReferenceRulesHandlerSettings>());
-		if (Settings == nullptr)
-		{
-			return false;
-		}
-	}
-	
-	if (RuleCanBeApplied(AssetPath) == false)
-	{
-		return false;
-	}
-
-	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName);
-
-	const FAssetData AssetData = AssetRegistry.Get().GetAssetByObjectPath(*AssetPath);
-
-	return CheckAllRules(AssetPath, AssetRegistry, AssetData, true, ValidationError)
-		|| CheckAllRules(AssetPath, AssetRegistry, AssetData, false, ValidationError);
-}
-
-bool UOWIReferenceRulesHandler::RuleCanBeApplied(const FString& AssetPath)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWIReferenceRulesHandlerSettings*>(GetDefault<UOWIReferenceRulesHandlerSettings>());
-		if (Settings == nullptr)
-		{
-			return false;
-		}
-	}
-	
-	if (Settings->bEnabled == false)
-	{
-		return false;
-	}
-
-	if (Settings->bCheckCircularDependencies || Settings->BlackList.Num() > 0)
-	{
-		// In case we have a blacklist or need to check circular dependencies we need to check everything
-		return true;
-	}
-
-	// Otherwise we only need to check this asset if it is in a path we have a rule for
-	for (const FOWIReferenceRule& Rule : Settings->ReferenceRules)
-	{
-		if (Rule.CanBeApplied(AssetPath))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool UOWIReferenceRulesHandler::CheckAllRules(const FString& AssetPath, const FAssetRegistryModule& AssetRegistry, const FAssetData& AssetData, const bool bHardDependencyType, FString& ValidationError)
-{
-	TArray<FName> References = TArray<FName>();
-	AssetRegistry.Get().GetDependencies(AssetData.PackageName, References, bHardDependencyType ? EAssetRegistryDependencyType::Hard : EAssetRegistryDependencyType::Soft);
-
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWIReferenceRulesHandlerSettings*>(GetDefault<UOWIReferenceRulesHandlerSettings>());
-		if (Settings == nullptr)
-		{
-			return false;
-		}
-	}	
-
-	if (IsBlackListed(AssetPath, References, ValidationError))
-	{
-		return true;
-	}
-	
-	if (bHardDependencyType && Settings->bCheckCircularDependencies && HasCircularDependency(*AssetPath, AssetRegistry, AssetData, ValidationError))
-	{
-		return true;
-	}
-	
-	for (const FOWIReferenceRule& Rule : Settings->ReferenceRules)
-	{
-		if (Rule.IsViolated(AssetPath, References, ValidationError))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool UOWIReferenceRulesHandler::IsBlackListed(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError)
-{
-	if (Settings == nullptr)
-	{
-		Settings = const_cast<UOWIReferenceRulesHandlerSettings*>(GetDefault<UOWIReferenceRulesHandlerSettings>());
-		if (Settings == nullptr)
-		{
-			return false;
-		}
-	}
-	
-	for (const FName& Reference : References)
-	{
-		for (const FDirectoryPath& BlackListItem : Settings->BlackList)
-		{
-			if (Reference.ToString().StartsWith(BlackListItem.Path)
-				&& AssetPath.StartsWith(BlackListItem.Path) == false)
-			{
-				ValidationError = AssetPath + " references " + Reference.ToString() + " in invalid folder " + BlackListItem.Path;
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
-bool UOWIReferenceRulesHandler::HasCircularDependency(const FString& AssetPath, const FAssetRegistryModule& AssetRegistry, const FAssetData& AssetData, FString& ValidationError)
-{
-	TArray<FName> References;
-	AssetRegistry.Get().GetDependencies(AssetData.PackageName, References, EAssetRegistryDependencyType::Hard);
-
-	for (const FName& Reference : References)
-	{
-		if (Reference.ToString().StartsWith("/Game/") == false || AssetData.PackageName.IsEqual(Reference))
-		{
-			continue;
-		}
-
-		if (Reference.ToString().StartsWith(AssetPath))
-		{
-			ValidationError = AssetPath + " has circular dependency.";
-			return true;
-		}
-
-		const FAssetData& NextAssetData = AssetRegistry.Get().GetAssetByObjectPath(Reference);
-		if (HasCircularDependency(AssetPath, AssetRegistry, NextAssetData, ValidationError))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
+// Copyright Offworld Industries
+
+#include "OWI_ReferenceRulesHandler.h"
+#include "Async/ParallelFor.h"
+#include "OWI_EditorEnhancements.h"
+#include "OWI_ValidationStats.h"
+#include "Runtime/AssetRegistry/Public/AssetRegistryModule.h"
+#include "Runtime/AssetRegistry/Public/IAssetRegistry.h"
+
+bool FOWIReferenceRule::IsViolated(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError) const
+{
+	if (FOWIPathTrie::IsInFolder(AssetPath, MayNotReferenceFolder.Path))
+	{
+		return false;
+	}
+
+	bool bViolated = false;
+	for (const FName& Reference : References)
+	{
+		if (FOWIPathTrie::IsInFolder(Reference, MayNotReferenceFolder.Path)
+			&& IsException(Reference) == false)
+		{
+			if (bViolated)
+			{
+				ValidationError.Append(LINE_TERMINATOR);
+			}
+			ValidationError.Append(AssetPath + " references " + Reference.ToString() + " in invalid folder " + MayNotReferenceFolder.Path);
+			bViolated = true;
+		}
+	}
+
+	return bViolated;
+}
+
+bool FOWIReferenceRule::CanBeApplied(const FString& AssetPath) const
+{
+	return FOWIPathTrie::IsInFolder(AssetPath, AssetFolder.Path);
+}
+
+bool FOWIReferenceRule::IsException(const FName& Reference) const
+{
+	for (const FDirectoryPath& ExceptionFolder : ExceptionFolders)
+	{
+		if (FOWIPathTrie::IsInFolder(Reference, ExceptionFolder.Path))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FOWIReferenceViolations::AddRuleViolation(const FName PackageName, const FName Reference, const int32 RuleIndex)
+{
+	FOWIReferenceViolation& Violation = Violations.AddDefaulted_GetRef();
+	Violation.PackageName = PackageName;
+	Violation.Reference = Reference;
+	Violation.Index = RuleIndex;
+	Violation.Kind = EOWIReferenceViolationKind::ReferenceRule;
+}
+
+void FOWIReferenceViolations::AddBlackListViolation(const FName PackageName, const FName Reference, const int32 EntryIndex)
+{
+	FOWIReferenceViolation& Violation = Violations.AddDefaulted_GetRef();
+	Violation.PackageName = PackageName;
+	Violation.Reference = Reference;
+	Violation.Index = EntryIndex;
+	Violation.Kind = EOWIReferenceViolationKind::BlackList;
+}
+
+void FOWIReferenceViolations::AddCircularDependency(const FName PackageName, const TArray<FName>& CyclePath)
+{
+	FOWIReferenceViolation& Violation = Violations.AddDefaulted_GetRef();
+	Violation.PackageName = PackageName;
+	Violation.FirstPathPackage = PathPackages.Num();
+	Violation.NumPathPackages = CyclePath.Num();
+	Violation.Kind = EOWIReferenceViolationKind::CircularDependency;
+	PathPackages.Append(CyclePath);
+}
+
+void FOWIReferenceViolations::AddTransitiveViolation(const FName PackageName, const EOWIReferenceViolationKind Kind, const int32 Index, const TArray<FName>& Path)
+{
+	FOWIReferenceViolation& Violation = Violations.AddDefaulted_GetRef();
+	Violation.PackageName = PackageName;
+	Violation.Reference = Path.Last();
+	Violation.Index = Index;
+	Violation.FirstPathPackage = PathPackages.Num();
+	Violation.NumPathPackages = Path.Num();
+	Violation.Kind = Kind;
+	PathPackages.Append(Path);
+}
+
+void FOWIReferenceViolations::Append(const FOWIReferenceViolations& Other)
+{
+	const int32 PathPackagesOffset = PathPackages.Num();
+	PathPackages.Append(Other.PathPackages);
+
+	Violations.Reserve(Violations.Num() + Other.Violations.Num());
+	for (const FOWIReferenceViolation& OtherViolation : Other.Violations)
+	{
+		FOWIReferenceViolation& Violation = Violations.Add_GetRef(OtherViolation);
+		if (Violation.NumPathPackages > 0)
+		{
+			Violation.FirstPathPackage += PathPackagesOffset;
+		}
+	}
+}
+
+void FOWIReferenceViolations::Reset()
+{
+	Violations.Reset();
+	PathPackages.Reset();
+}
+
+FString FOWIReferenceViolations::ToString(const int32 ViolationIndex, const UOWIReferenceRulesHandlerSettings& Settings) const
+{
+	const FOWIReferenceViolation& Violation = Violations[ViolationIndex];
+
+	// The rules may have been edited since
+	FString Folder;
+	switch (Violation.Kind)
+	{
+	case EOWIReferenceViolationKind::ReferenceRule:
+	case EOWIReferenceViolationKind::TransitiveReferenceRule:
+		Folder = Settings.ReferenceRules.IsValidIndex(Violation.Index) ? Settings.ReferenceRules[Violation.Index].MayNotReferenceFolder.Path : FString();
+		break;
+	case EOWIReferenceViolationKind::BlackList:
+	case EOWIReferenceViolationKind::TransitiveBlackList:
+		Folder = Settings.BlackList.IsValidIndex(Violation.Index) ? Settings.BlackList[Violation.Index].Path : FString();
+		break;
+	default:
+		break;
+	}
+
+	FString ValidationError;
+	switch (Violation.Kind)
+	{
+	case EOWIReferenceViolationKind::ReferenceRule:
+	case EOWIReferenceViolationKind::BlackList:
+		return Violation.PackageName.ToString() + " references " + Violation.Reference.ToString() + " in invalid folder " + Folder;
+	case EOWIReferenceViolationKind::CircularDependency:
+		ValidationError = Violation.PackageName.ToString() + " has circular dependency:";
+		break;
+	case EOWIReferenceViolationKind::TransitiveReferenceRule:
+	case EOWIReferenceViolationKind::TransitiveBlackList:
+		ValidationError = Violation.PackageName.ToString() + " indirectly references " + Violation.Reference.ToString() + " in invalid folder " + Folder + " through";
+		break;
+	default:
+		return FString();
+	}
+
+	for (int32 PathIndex = 0; PathIndex < Violation.NumPathPackages; ++PathIndex)
+	{
+		ValidationError.Append(PathIndex == 0 ? " " : " -> ").Append(PathPackages[Violation.FirstPathPackage + PathIndex].ToString());
+	}
+	return ValidationError;
+}
+
+FString FOWIReferenceViolations::ToString(const UOWIReferenceRulesHandlerSettings& Settings) const
+{
+	FString ValidationError;
+	for (int32 ViolationIndex = 0; ViolationIndex < Violations.Num(); ++ViolationIndex)
+	{
+		if (ViolationIndex > 0)
+		{
+			ValidationError.Append(LINE_TERMINATOR);
+		}
+		ValidationError.Append(ToString(ViolationIndex, Settings));
+	}
+
+	return ValidationError;
+}
+
+#if WITH_EDITOR
+void UOWIReferenceRulesHandlerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateCompiledRules();
+}
+#endif
+
+void UOWIReferenceRulesHandlerSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	InvalidateCompiledRules();
+}
+
+const FOWIReferenceRulesMatcher& UOWIReferenceRulesHandlerSettings::GetCompiledRules() const
+{
+	if (bRulesCompiled == false)
+	{
+		CompiledRules.Compile(ReferenceRules, BlackList);
+		bRulesCompiled = true;
+	}
+
+	return CompiledRules;
+}
+
+void UOWIReferenceRulesHandlerSettings::InvalidateCompiledRules()
+{
+	bRulesCompiled = false;
+}
+
+bool UOWIReferenceRulesHandler::RuleIsViolated(const FString& AssetPath, FString& ValidationError, const EOWIReferenceCheckScope Scope)
+{
+	FOWIReferenceViolations Violations;
+	if (RuleIsViolated(AssetPath, Violations, Scope) == false)
+	{
+		return false;
+	}
+
+	ValidationError = Violations.ToString(*Settings);
+	return true;
+}
+
+bool UOWIReferenceRulesHandler::RuleIsViolated(const FString& AssetPath, FOWIReferenceViolations& OutViolations, const EOWIReferenceCheckScope Scope)
+{
+	const EOWIReferenceCheckScope EnabledScope = GetEnabledScope(Scope);
+	if (EnabledScope == EOWIReferenceCheckScope::None || RuleCanBeApplied(AssetPath) == false)
+	{
+		return false;
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(*AssetPath);
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::RegistryQueries);
+
+	FOWIPackageDependencies Dependencies;
+	GatherDependencies(AssetData.PackageName, AssetRegistry, Dependencies);
+
+	return CheckPackage(AssetPath, Dependencies, AssetRegistry, EnabledScope, OutViolations);
+}
+
+bool UOWIReferenceRulesHandler::RuleCanBeApplied(const FString& AssetPath)
+{
+	if (LoadSettings() == false || Settings->bEnabled == false)
+	{
+		return false;
+	}
+
+	if (Settings->bCheckCircularDependencies || Settings->bCheckTransitiveReferences || Settings->BlackList.Num() > 0)
+	{
+		// In case we have a blacklist or need to check circular dependencies we need to check everything
+		return true;
+	}
+
+	// Otherwise we only need to check this asset if it is in a path we have a rule for
+	return Settings->GetCompiledRules().CanBeApplied(AssetPath);
+}
+
+bool UOWIReferenceRulesHandler::ValidatePackages(const TArray<FName>& PackageNames, TMap<FName, FString>& OutValidationErrors)
+{
+	FOWIReferenceViolations Violations;
+	if (ValidatePackages(PackageNames, Violations, EOWIReferenceCheckScope::All) == false)
+	{
+		return false;
+	}
+
+	// The violations are ordered by package, so every package gets all of its lines at once
+	for (int32 ViolationIndex = 0; ViolationIndex < Violations.Num(); ++ViolationIndex)
+	{
+		FString& ValidationError = OutValidationErrors.FindOrAdd(Violations.Violations[ViolationIndex].PackageName);
+		if (ValidationError.IsEmpty() == false)
+		{
+			ValidationError.Append(LINE_TERMINATOR);
+		}
+		ValidationError.Append(Violations.ToString(ViolationIndex, *Settings));
+	}
+
+	return true;
+}
+
+bool UOWIReferenceRulesHandler::ValidatePackages(const TArray<FName>& PackageNames, FOWIReferenceViolations& OutViolations, const EOWIReferenceCheckScope Scope)
+{
+	const EOWIReferenceCheckScope EnabledScope = GetEnabledScope(Scope);
+	if (EnabledScope == EOWIReferenceCheckScope::None)
+	{
+		return false;
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	// Fetch all dependencies up front, the rules themselves only work on these lists
+	TArray<FOWIPackageDependencies> AllDependencies;
+	AllDependencies.Reserve(PackageNames.Num());
+	for (const FName& PackageName : PackageNames)
+	{
+		if (RuleCanBeApplied(PackageName.ToString()))
+		{
+			GatherDependencies(PackageName, AssetRegistry, AllDependencies.AddDefaulted_GetRef());
+		}
+	}
+
+	// Compile on this thread, the workers only read the compiled rules
+	Settings->GetCompiledRules();
+
+	// Every package writes its own slot, so the workers never have to synchronize
+	TArray<FOWIReferenceViolations> PackageViolations;
+	PackageViolations.SetNum(AllDependencies.Num());
+	if (EnumHasAnyFlags(EnabledScope, EOWIReferenceCheckScope::Local))
+	{
+		ParallelFor(AllDependencies.Num(), [this, &AllDependencies, &PackageViolations](const int32 PackageIndex)
+		{
+			const FOWIPackageDependencies& Dependencies = AllDependencies[PackageIndex];
+			CheckRules(Dependencies.PackageName.ToString(), Dependencies, PackageViolations[PackageIndex]);
+		});
+	}
+
+	// The detector explores the graph on demand and isn't thread safe, so cycles are found afterwards on this thread
+	if (EnumHasAnyFlags(EnabledScope, EOWIReferenceCheckScope::Graph) && Settings->bCheckCircularDependencies)
+	{
+		for (int32 PackageIndex = 0; PackageIndex < AllDependencies.Num(); ++PackageIndex)
+		{
+			HasCircularDependency(AllDependencies[PackageIndex], AssetRegistry, PackageViolations[PackageIndex]);
+		}
+	}
+
+	// The reachability index is explored on demand as well
+	if (EnumHasAnyFlags(EnabledScope, EOWIReferenceCheckScope::Graph) && Settings->bCheckTransitiveReferences)
+	{
+		for (int32 PackageIndex = 0; PackageIndex < AllDependencies.Num(); ++PackageIndex)
+		{
+			const FOWIPackageDependencies& Dependencies = AllDependencies[PackageIndex];
+			HasTransitiveViolation(Dependencies.PackageName.ToString(), Dependencies, AssetRegistry, PackageViolations[PackageIndex]);
+		}
+	}
+
+	const int32 NumViolations = OutViolations.Num();
+	for (const FOWIReferenceViolations& Violations : PackageViolations)
+	{
+		OutViolations.Append(Violations);
+	}
+
+	return OutViolations.Num() > NumViolations;
+}
+
+bool UOWIReferenceRulesHandler::ValidatePath(const FString& RootPath, TMap<FName, FString>& OutValidationErrors)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.SearchAllAssets(true);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(*RootPath, Assets, true);
+
+	// A package may contain more than one Asset
+	TSet<FName> PackageNames;
+	PackageNames.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		PackageNames.Add(Asset.PackageName);
+	}
+
+	return ValidatePackages(PackageNames.Array(), OutValidationErrors);
+}
+
+void UOWIReferenceRulesHandler::ResetCaches()
+{
+	CircularDependencyDetector.Reset();
+	ReachabilityIndex.Reset(0);
+}
+
+const UOWIReferenceRulesHandlerSettings* UOWIReferenceRulesHandler::GetSettings()
+{
+	LoadSettings();
+	return Settings;
+}
+
+EOWIReferenceCheckScope UOWIReferenceRulesHandler::GetEnabledScope(EOWIReferenceCheckScope Scope)
+{
+	if (LoadSettings() == false || Settings->bEnabled == false)
+	{
+		return EOWIReferenceCheckScope::None;
+	}
+
+	if (Settings->bCheckCircularDependencies == false && Settings->bCheckTransitiveReferences == false)
+	{
+		EnumRemoveFlags(Scope, EOWIReferenceCheckScope::Graph);
+	}
+
+	return Scope;
+}
+
+bool UOWIReferenceRulesHandler::LoadSettings()
+{
+	if (Settings == nullptr)
+	{
+		Settings = const_cast<UOWIReferenceRulesHandlerSettings*>(GetDefault<UOWIReferenceRulesHandlerSettings>());
+	}
+
+	return Settings != nullptr;
+}
+
+void UOWIReferenceRulesHandler::GatherDependencies(const FName PackageName, const IAssetRegistry& AssetRegistry, FOWIPackageDependencies& OutDependencies)
+{
+	OWI_VALIDATION_SCOPE(GatherDependencies);
+	FOWIEditorEnhancementsModule::GetDependencyGraph().GetDependencies(PackageName, AssetRegistry, OutDependencies);
+}
+
+bool UOWIReferenceRulesHandler::CheckPackage(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, const EOWIReferenceCheckScope Scope, FOWIReferenceViolations& OutViolations)
+{
+	if (LoadSettings() == false)
+	{
+		return false;
+	}
+
+	bool bViolated = false;
+	if (EnumHasAnyFlags(Scope, EOWIReferenceCheckScope::Local))
+	{
+		bViolated |= CheckRules(AssetPath, Dependencies, OutViolations);
+	}
+	if (EnumHasAnyFlags(Scope, EOWIReferenceCheckScope::Graph) && Settings->bCheckCircularDependencies)
+	{
+		bViolated |= HasCircularDependency(Dependencies, AssetRegistry, OutViolations);
+	}
+	if (EnumHasAnyFlags(Scope, EOWIReferenceCheckScope::Graph) && Settings->bCheckTransitiveReferences)
+	{
+		bViolated |= HasTransitiveViolation(AssetPath, Dependencies, AssetRegistry, OutViolations);
+	}
+
+	return bViolated;
+}
+
+bool UOWIReferenceRulesHandler::CheckRules(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, FOWIReferenceViolations& OutViolations) const
+{
+	OWI_VALIDATION_SCOPE(ReferenceRules);
+
+	FOWIReferenceRulesAssetContext AssetContext;
+	Settings->GetCompiledRules().ClassifyAsset(AssetPath, AssetContext);
+
+	// Every reference is matched against every rule applying to the Asset
+	int32 NumApplicableRules = 0;
+	for (TConstSetBitIterator<> It(AssetContext.ApplicableRules); It; ++It)
+	{
+		++NumApplicableRules;
+	}
+	FOWIValidationStats& Stats = FOWIValidationStats::Get();
+	Stats.Add(EOWIValidationCounter::ReferenceRulesChecked);
+	Stats.Add(EOWIValidationCounter::RulesEvaluated, static_cast<int64>(NumApplicableRules) * Dependencies.Dependencies.Num());
+
+	return CheckAllRules(Dependencies.PackageName, AssetContext, Dependencies.Dependencies, OutViolations);
+}
+
+bool UOWIReferenceRulesHandler::CheckAllRules(const FName PackageName, const FOWIReferenceRulesAssetContext& AssetContext, const TArray<FName>& References, FOWIReferenceViolations& OutViolations) const
+{
+	bool bViolated = IsBlackListed(PackageName, AssetContext, References, OutViolations);
+	
+	const FOWIReferenceRulesMatcher& CompiledRules = Settings->GetCompiledRules();
+	for (const FName& Reference : References)
+	{
+		const int32 RuleIndex = CompiledRules.FindViolatedRule(AssetContext, Reference);
+		if (RuleIndex != INDEX_NONE)
+		{
+			OutViolations.AddRuleViolation(PackageName, Reference, RuleIndex);
+			bViolated = true;
+		}
+	}
+
+	return bViolated;
+}
+
+bool UOWIReferenceRulesHandler::IsBlackListed(const FName PackageName, const FOWIReferenceRulesAssetContext& AssetContext, const TArray<FName>& References, FOWIReferenceViolations& OutViolations) const
+{
+	bool bBlackListed = false;
+	const FOWIReferenceRulesMatcher& CompiledRules = Settings->GetCompiledRules();
+	for (const FName& Reference : References)
+	{
+		const int32 EntryIndex = CompiledRules.FindBlackListEntry(AssetContext, Reference);
+		if (EntryIndex != INDEX_NONE)
+		{
+			OutViolations.AddBlackListViolation(PackageName, Reference, EntryIndex);
+			bBlackListed = true;
+		}
+	}
+
+	return bBlackListed;
+}
+
+bool UOWIReferenceRulesHandler::HasCircularDependency(const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, FOWIReferenceViolations& OutViolations)
+{
+	if (Dependencies.PackageName.IsNone())
+	{
+		return false;
+	}
+
+	OWI_VALIDATION_SCOPE(CircularDependencies);
+
+	TArray<FName> CyclePath;
+	const bool bHasCycle = CircularDependencyDetector.FindCycle(Dependencies.PackageName, [&AssetRegistry, &Dependencies](const FName DependencyPackageName, TArray<FName>& OutDependencies)
+	{
+		// The checked package was already fetched for the rules, only the packages reached from it need a query
+		if (DependencyPackageName == Dependencies.PackageName)
+		{
+			OutDependencies.Append(Dependencies.GetHardDependencies());
+		} else
+		{
+			FOWIEditorEnhancementsModule::GetDependencyGraph().GetHardDependencies(DependencyPackageName, AssetRegistry, OutDependencies);
+		}
+
+		// Only dependencies within the project are of interest
+		static const FString GameFolder = TEXT("/Game");
+		OutDependencies.RemoveAll([](const FName& Dependency)
+		{
+			return FOWIPathTrie::IsInFolder(Dependency, GameFolder) == false;
+		});
+	}, CyclePath);
+
+	if (bHasCycle == false)
+	{
+		return false;
+	}
+
+	OutViolations.AddCircularDependency(Dependencies.PackageName, CyclePath);
+	return true;
+}
+
+bool UOWIReferenceRulesHandler::HasTransitiveViolation(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, FOWIReferenceViolations& OutViolations)
+{
+	if (Dependencies.PackageName.IsNone() || Dependencies.Dependencies.Num() == 0)
+	{
+		return false;
+	}
+
+	OWI_VALIDATION_SCOPE(TransitiveReferences);
+
+	// A bit per rule followed by a bit per BlackList entry
+	const FOWIReferenceRulesMatcher& CompiledRules = Settings->GetCompiledRules();
+	const int32 NumRules = CompiledRules.GetNumRules();
+	const int32 NumBits = NumRules + CompiledRules.GetNumBlackListEntries();
+	// The bits of an explored graph mean nothing once the rules or the BlackList changed their count
+	if (ReachabilityIndex.GetNumBits() != NumBits)
+	{
+		ReachabilityIndex.Reset(NumBits);
+	}
+
+	TBitArray<> ReachableBits(false, NumBits);
+	for (const FName& Dependency : Dependencies.Dependencies)
+	{
+		ReachabilityIndex.AddReachableBits(Dependency, [&AssetRegistry](const FName PackageName, TArray<FName>& OutDependencies)
+		{
+			// Native packages have no dependencies worth following
+			static const FString ScriptFolder = TEXT("/Script");
+			if (FOWIPathTrie::IsInFolder(PackageName, ScriptFolder) == false)
+			{
+				FOWIPackageDependencies PackageDependencies;
+				FOWIEditorEnhancementsModule::GetDependencyGraph().GetDependencies(PackageName, AssetRegistry, PackageDependencies);
+				OutDependencies = MoveTemp(PackageDependencies.Dependencies);
+			}
+		}, [&CompiledRules](const FName PackageName, TBitArray<>& OutBits)
+		{
+			CompiledRules.ClassifyReference(PackageName, OutBits);
+		}, ReachableBits);
+	}
+
+	FOWIReferenceRulesAssetContext AssetContext;
+	CompiledRules.ClassifyAsset(AssetPath, AssetContext);
+
+	bool bViolated = false;
+	TArray<FName> Path;
+	for (TConstSetBitIterator<> It(ReachableBits); It; ++It)
+	{
+		const int32 Bit = It.GetIndex();
+		const bool bRule = Bit < NumRules;
+		const bool bApplies = bRule ? AssetContext.ApplicableRules[Bit] : AssetContext.ContainingBlackListEntries[Bit - NumRules] == false;
+
+		// A chain of a single package is a direct reference, which CheckRules reports already
+		if (bApplies && ReachabilityIndex.FindPath(Dependencies.Dependencies, Bit, Path) && Path.Num() > 1)
+		{
+			OutViolations.AddTransitiveViolation(Dependencies.PackageName,
+				bRule ? EOWIReferenceViolationKind::TransitiveReferenceRule : EOWIReferenceViolationKind::TransitiveBlackList,
+				bRule ? Bit : Bit - NumRules, Path);
+			bViolated = true;
+		}
+	}
+
+	return bViolated;
+}
@@ -0,0 +1,152 @@
+// Copyright Offworld Industries
+
+#include "OWI_ReferenceRulesMatcher.h"
+#include "OWI_ReferenceRulesHandler.h"
+
+void FOWIReferenceRulesMatcher::Compile(const TArray<FOWIReferenceRule>& Rules, const TArray<FDirectoryPath>& BlackList)
+{
+	Trie.Reset();
+	NumRules = Rules.Num();
+	NumBlackListEntries = BlackList.Num();
+
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FOWIReferenceRule& Rule = Rules[RuleIndex];
+		Trie.Insert(Rule.AssetFolder.Path, MakeTag(ETagType::AssetFolder, RuleIndex));
+		Trie.Insert(Rule.MayNotReferenceFolder.Path, MakeTag(ETagType::MayNotReferenceFolder, RuleIndex));
+
+		for (const FDirectoryPath& ExceptionFolder : Rule.ExceptionFolders)
+		{
+			Trie.Insert(ExceptionFolder.Path, MakeTag(ETagType::ExceptionFolder, RuleIndex));
+		}
+	}
+
+	for (int32 EntryIndex = 0; EntryIndex < BlackList.Num(); ++EntryIndex)
+	{
+		Trie.Insert(BlackList[EntryIndex].Path, MakeTag(ETagType::BlackList, EntryIndex));
+	}
+}
+
+bool FOWIReferenceRulesMatcher::CanBeApplied(const FString& AssetPath) const
+{
+	bool bCanBeApplied = false;
+	Trie.ForEachPrefixTag(AssetPath, [&bCanBeApplied](const int32 Tag)
+	{
+		bCanBeApplied |= GetTagType(Tag) == ETagType::AssetFolder;
+	});
+
+	return bCanBeApplied;
+}
+
+void FOWIReferenceRulesMatcher::ClassifyAsset(const FString& AssetPath, FOWIReferenceRulesAssetContext& OutContext) const
+{
+	OutContext.ApplicableRules.Init(false, NumRules);
+	OutContext.ContainingBlackListEntries.Init(false, NumBlackListEntries);
+
+	// Assets inside the folder they may not reference are fine, so remember those to mask them out afterwards
+	TBitArray<> ContainingMayNotReferenceFolders(false, NumRules);
+
+	Trie.ForEachPrefixTag(AssetPath, [&OutContext, &ContainingMayNotReferenceFolders](const int32 Tag)
+	{
+		switch (GetTagType(Tag))
+		{
+		case ETagType::AssetFolder:
+			OutContext.ApplicableRules[GetTagIndex(Tag)] = true;
+			break;
+		case ETagType::MayNotReferenceFolder:
+			ContainingMayNotReferenceFolders[GetTagIndex(Tag)] = true;
+			break;
+		case ETagType::BlackList:
+			OutContext.ContainingBlackListEntries[GetTagIndex(Tag)] = true;
+			break;
+		default:
+			break;
+		}
+	});
+
+	for (TConstSetBitIterator<> It(ContainingMayNotReferenceFolders); It; ++It)
+	{
+		OutContext.ApplicableRules[It.GetIndex()] = false;
+	}
+}
+
+int32 FOWIReferenceRulesMatcher::FindViolatedRule(const FOWIReferenceRulesAssetContext& Context, const FName Reference) const
+{
+	// Exceptions may sit deeper in the trie than the forbidden folder, so only decide after the full walk
+	TArray<int32, TInlineAllocator<8>> ForbiddenRules;
+	TArray<int32, TInlineAllocator<8>> ExceptedRules;
+
+	Trie.ForEachPrefixTag(Reference, [&Context, &ForbiddenRules, &ExceptedRules](const int32 Tag)
+	{
+		const int32 RuleIndex = GetTagIndex(Tag);
+		switch (GetTagType(Tag))
+		{
+		case ETagType::MayNotReferenceFolder:
+			if (Context.ApplicableRules[RuleIndex])
+			{
+				ForbiddenRules.Add(RuleIndex);
+			}
+			break;
+		case ETagType::ExceptionFolder:
+			ExceptedRules.Add(RuleIndex);
+			break;
+		default:
+			break;
+		}
+	});
+
+	for (const int32 RuleIndex : ForbiddenRules)
+	{
+		if (ExceptedRules.Contains(RuleIndex) == false)
+		{
+			return RuleIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FOWIReferenceRulesMatcher::FindBlackListEntry(const FOWIReferenceRulesAssetContext& Context, const FName Reference) const
+{
+	int32 EntryIndex = INDEX_NONE;
+	Trie.ForEachPrefixTag(Reference, [&Context, &EntryIndex](const int32 Tag)
+	{
+		if (EntryIndex == INDEX_NONE
+			&& GetTagType(Tag) == ETagType::BlackList
+			&& Context.ContainingBlackListEntries[GetTagIndex(Tag)] == false)
+		{
+			EntryIndex = GetTagIndex(Tag);
+		}
+	});
+
+	return EntryIndex;
+}
+
+void FOWIReferenceRulesMatcher::ClassifyReference(const FName Reference, TBitArray<>& OutForbiddenBits) const
+{
+	TArray<int32, TInlineAllocator<8>> ExceptedRules;
+
+	Trie.ForEachPrefixTag(Reference, [this, &OutForbiddenBits, &ExceptedRules](const int32 Tag)
+	{
+		const int32 Index = GetTagIndex(Tag);
+		switch (GetTagType(Tag))
+		{
+		case ETagType::MayNotReferenceFolder:
+			OutForbiddenBits[Index] = true;
+			break;
+		case ETagType::ExceptionFolder:
+			ExceptedRules.Add(Index);
+			break;
+		case ETagType::BlackList:
+			OutForbiddenBits[NumRules + Index] = true;
+			break;
+		default:
+			break;
+		}
+	});
+
+	for (const int32 RuleIndex : ExceptedRules)
+	{
+		OutForbiddenBits[RuleIndex] = false;
+	}
+}
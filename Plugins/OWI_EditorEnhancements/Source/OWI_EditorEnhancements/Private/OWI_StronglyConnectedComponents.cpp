@@ -0,0 +1,130 @@
+// Copyright Offworld Industries
+
+#include "OWI_StronglyConnectedComponents.h"
+
+void FOWIStronglyConnectedComponents::Reset()
+{
+	Nodes.Reset();
+	NodeIndices.Reset();
+	NextComponent = 0;
+	NextIndex = 0;
+}
+
+int32 FOWIStronglyConnectedComponents::FindOrAddNode(const FName PackageName)
+{
+	if (const int32* ExistingNode = NodeIndices.Find(PackageName))
+	{
+		return *ExistingNode;
+	}
+
+	const int32 NewNode = Nodes.AddDefaulted();
+	Nodes[NewNode].PackageName = PackageName;
+	NodeIndices.Add(PackageName, NewNode);
+	return NewNode;
+}
+
+int32 FOWIStronglyConnectedComponents::FindNode(const FName PackageName) const
+{
+	const int32* Node = NodeIndices.Find(PackageName);
+	return Node != nullptr ? *Node : INDEX_NONE;
+}
+
+int32 FOWIStronglyConnectedComponents::Num() const
+{
+	return Nodes.Num();
+}
+
+int32 FOWIStronglyConnectedComponents::NumComponents() const
+{
+	return NextComponent;
+}
+
+void FOWIStronglyConnectedComponents::Visit(const int32 Node, const FGetDependencies GetDependencies, const FOnVisit OnVisit, TArray<int32>& Stack)
+{
+	TArray<FName> Dependencies;
+	GetDependencies(Nodes[Node].PackageName, Dependencies);
+
+	TArray<int32> DependencyNodes;
+	DependencyNodes.Reserve(Dependencies.Num());
+	for (const FName& Dependency : Dependencies)
+	{
+		if (Dependency != Nodes[Node].PackageName)
+		{
+			DependencyNodes.AddUnique(FindOrAddNode(Dependency));
+		}
+	}
+
+	// FindOrAddNode may have reallocated Nodes, so only access the node afterwards
+	FNode& VisitedNode = Nodes[Node];
+	VisitedNode.Dependencies = MoveTemp(DependencyNodes);
+	VisitedNode.Index = NextIndex;
+	VisitedNode.LowLink = NextIndex;
+	VisitedNode.bOnStack = true;
+	++NextIndex;
+	Stack.Push(Node);
+
+	OnVisit(Node);
+}
+
+void FOWIStronglyConnectedComponents::Explore(const int32 StartNode, const FGetDependencies GetDependencies, const FOnVisit OnVisit, const FOnComponent OnComponent)
+{
+	if (Nodes[StartNode].Component != INDEX_NONE)
+	{
+		return;
+	}
+
+	// Node and the next dependency to look at, replaces the recursion of the textbook algorithm
+	TArray<TPair<int32, int32>> CallStack;
+	TArray<int32> Stack;
+	TArray<int32> Members;
+
+	Visit(StartNode, GetDependencies, OnVisit, Stack);
+	CallStack.Emplace(StartNode, 0);
+
+	while (CallStack.Num() > 0)
+	{
+		const int32 Node = CallStack.Last().Key;
+		const int32 DependencyIndex = CallStack.Last().Value;
+
+		if (DependencyIndex < Nodes[Node].Dependencies.Num())
+		{
+			++CallStack.Last().Value;
+			const int32 Dependency = Nodes[Node].Dependencies[DependencyIndex];
+
+			if (Nodes[Dependency].Index == INDEX_NONE)
+			{
+				Visit(Dependency, GetDependencies, OnVisit, Stack);
+				CallStack.Emplace(Dependency, 0);
+			} else if (Nodes[Dependency].bOnStack)
+			{
+				Nodes[Node].LowLink = FMath::Min(Nodes[Node].LowLink, Nodes[Dependency].Index);
+			}
+			continue;
+		}
+
+		CallStack.Pop(false);
+
+		if (Nodes[Node].LowLink == Nodes[Node].Index)
+		{
+			// Node is the root of a component, everything above it on the stack belongs to it
+			const int32 Component = NextComponent++;
+			Members.Reset();
+			int32 Member;
+			do
+			{
+				Member = Stack.Pop(false);
+				Nodes[Member].bOnStack = false;
+				Nodes[Member].Component = Component;
+				Members.Add(Member);
+			} while (Member != Node);
+
+			OnComponent(Component, Members);
+		}
+
+		if (CallStack.Num() > 0)
+		{
+			const int32 Parent = CallStack.Last().Key;
+			Nodes[Parent].LowLink = FMath::Min(Nodes[Parent].LowLink, Nodes[Node].LowLink);
+		}
+	}
+}
@@ -1,376 +1,530 @@
-// Copyright Offworld Industries
-
-#include "OWI_UnReleasedAssetsHandler.h"
-#include "Misc/ConfigCacheIni.h"
-#include "ContentBrowserModule.h"
-#include "Misc/FileHelper.h"
-#include "OWI_ReferenceRulesHandler.h"
-#include "Editor/ContentBrowser/Private/ContentBrowserUtils.h"
-#include "Engine/EngineTypes.h"
-#include "Settings/ProjectPackagingSettings.h"
-#include "EditorAssetLibrary.h"
-#include "Logging/TokenizedMessage.h"
-
-DEFINE_LOG_CATEGORY(LogUnReleasedAssetHandler);
-
-bool UOWIUnReleasedAssetsHandler::LoadSettings()
-{
-	Settings = GetMutableDefault<UOWIUnReleasedAssetsHandlerSettings>();
-	ReferenceRulesSettings = GetMutableDefault<UOWIReferenceRulesHandlerSettings>();
-	PackagingSettings = GetMutableDefault<UProjectPackagingSettings>();
-
-	if (Settings == nullptr || ReferenceRulesSettings == nullptr || PackagingSettings == nullptr)
-	{
-		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not read all settings!"));
-		return false;
-	}
-
-	// Sort the Folders
-	Settings->UnreleasedFolders.HeapSort();
-	Settings->MixedFolders.HeapSort();
-	Settings->ReleasedFolders.HeapSort();
-	
-	return true;
-}
-
-void UOWIUnReleasedAssetsHandler::SaveSettings() const
-{
-	Settings->UpdateDefaultConfigFile(Settings->GetDefaultConfigFilename());
-	ReferenceRulesSettings->UpdateDefaultConfigFile(ReferenceRulesSettings->GetDefaultConfigFilename());
-	PackagingSettings->UpdateDefaultConfigFile(PackagingSettings->GetDefaultConfigFilename());
-}
-
-void UOWIUnReleasedAssetsHandler::ReleaseFolder(const FString FolderPath)
-{
-	if (!LoadSettings())
-	{
-		return;
-	}
-		
-	// Remove Folder from reference rules
-	ReferenceRulesSettings->ReferenceRules.RemoveAll([&](const auto& Rule)
-    {
-        return Rule.AssetFolder.Path.Equals(Settings->AssetFolderToNotBeReferenced.Path)
-            && Rule.MayNotReferenceFolder.Path.Equals(FolderPath);
-    });
-
-	// Remove Folder from never cooking
-	PackagingSettings->DirectoriesToNeverCook.RemoveAll([&FolderPath](const auto& TempDirectoryPath)
-	{
-		return TempDirectoryPath.Path.Equals(FolderPath);
-	});
-	
-	// Remove Folder from Mod SDK Blacklist (Does this really need to be done? Not mentioned on Confluence page)
-	RemoveFolderFromModSDKBlacklist(GetModSDKCompatibleFolderName(FolderPath));	
-
-	// Update the internal config
-	UpdateInternalConfig(FolderPath, Released);
-	
-	// Also update the parent folder
-	UpdateParentFolder(FolderPath, true);
-	
-	// Save the Settings
-	SaveSettings();
-}
-
-void UOWIUnReleasedAssetsHandler::UnreleaseFolder(const FString FolderPath)
-{
-	if (!LoadSettings())
-	{
-		return;
-	}
-	
-	const FDirectoryPath DirectoryPath = { FolderPath };
-	
-	// Add Folder to reference rules if not yet in there
-	const FOWIReferenceRule TempRule { Settings->AssetFolderToNotBeReferenced, DirectoryPath };
-	if (!ReferenceRulesSettings->ReferenceRules.ContainsByPredicate([&TempRule](const FOWIReferenceRule& TempInnerRule)
-        {
-            return TempRule.AssetFolder.Path.Equals(TempInnerRule.AssetFolder.Path)
-                && TempRule.MayNotReferenceFolder.Path.Equals(TempInnerRule.MayNotReferenceFolder.Path);
-        }))
-	{
-		ReferenceRulesSettings->ReferenceRules.Add(TempRule);
-	}
-	
-	// Add Folder to never cook if not yet in there
-	if (!PackagingSettings->DirectoriesToNeverCook.ContainsByPredicate([&DirectoryPath](const FDirectoryPath TempDirectoryPath)
-        {
-            return DirectoryPath.Path.Equals(TempDirectoryPath.Path);
-        }))
-	{
-		PackagingSettings->DirectoriesToNeverCook.Add(DirectoryPath);
-	}
-	
-	// Add Folder to Mod SDK Blacklist
-	AddFolderToModSDKBlacklist(GetModSDKCompatibleFolderName(FolderPath));
-
-	// Update the internal config
-	UpdateInternalConfig(FolderPath, Unreleased);
-
-	// Update the internal config
-	UpdateParentFolder(FolderPath, false);
-	
-	// Save the Settings
-	SaveSettings();
-}
-
-void UOWIUnReleasedAssetsHandler::UpdateFolderColorsOnStart()
-{
-	if (!LoadSettings())
-	{
-		return;
-	}
-
-	for (auto& Path : Settings->UnreleasedFolders)
-	{
-		UpdateColor(Path, Unreleased);
-	}
-
-	for (auto& Path : Settings->ReleasedFolders)
-	{
-		UpdateColor(Path, Released);
-	}
-
-	for (auto& Path : Settings->MixedFolders)
-	{
-		UpdateColor(Path, Mixed);
-	}
-}
-
-EPathState UOWIUnReleasedAssetsHandler::GetFolderState(TArray<FString> Folders)
-{
-	EPathState PathState = None;
-	if (!LoadSettings())
-	{
-		return PathState;
-	}
-	
-	for (auto& Path : Folders)
-	{
-		if (Settings->UnreleasedFolders.ContainsByPredicate([&Path](const auto& Folder)
-	        {
-	            return Path.StartsWith(Folder);
-	        }))
-		{
-			if (PathState == None)
-			{
-				PathState = Unreleased;
-			} else if (PathState == Released)
-			{
-				PathState = Mixed;
-				break;
-			}  
-		} else
-		{
-			if (PathState == None)
-			{
-				PathState = Released;
-			} else if (PathState == Unreleased)
-			{
-				PathState = Mixed;
-				break;
-			}
-		}
-	}
-	
-	return PathState;
-}
-
-void UOWIUnReleasedAssetsHandler::AddFolderToModSDKBlacklist(const FString FolderPath) const
-{
-	FString Content;
-	if (LoadModSDKFile(Content))
-	{
-		const int32 BlacklistStart = Content.Find(Settings->ModSDKBlacklistStringStart) + Settings->ModSDKBlacklistStringStart.Len();
-		Content.InsertAt(BlacklistStart, FolderPath);
-		SaveModSDKFile(Content);
-	}
-}
-
-void UOWIUnReleasedAssetsHandler::RemoveFolderFromModSDKBlacklist(const FString FolderPath) const
-{
-	FString Content;
-	if (LoadModSDKFile(Content))
-	{
-		const int32 FolderPathStart = Content.Find(FolderPath);
-		Content.RemoveAt(FolderPathStart, FolderPath.Len());
-		SaveModSDKFile(Content);
-	}
-}
-
-bool UOWIUnReleasedAssetsHandler::LoadModSDKFile(FString& Content) const
-{
-	if (!FPaths::FileExists(Settings->ModSDKFile.FilePath))
-	{
-		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not find ModSDK file: %s!"), *Settings->ModSDKFile.FilePath);
-		return false;
-	}
-	
-	FFileHelper::LoadFileToString(Content, *Settings->ModSDKFile.FilePath);
-	return true;
-}
-
-void UOWIUnReleasedAssetsHandler::SaveModSDKFile(const FString Content) const
-{
-	if (!FFileHelper::SaveStringToFile(Content, *Settings->ModSDKFile.FilePath))
-	{
-		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not save ModSDK file: %s!"), *Settings->ModSDKFile.FilePath);
-	}
-}
-
-FString UOWIUnReleasedAssetsHandler::GetModSDKCompatibleFolderName(FString FolderPath)
-{
-	FolderPath.RemoveFromStart("/Game");
-	return "\n\t\"" + FolderPath + "\"";
-}
-
-void UOWIUnReleasedAssetsHandler::UpdateInternalConfig(const FString FolderPath, const EPathState NewPathState) const
-{
-	if (NewPathState == Released)
-	{
-		Settings->ReleasedFolders.AddUnique(FolderPath);
-		Settings->UnreleasedFolders.Remove(FolderPath);
-		Settings->MixedFolders.Remove(FolderPath);
-	} else  if (NewPathState == Unreleased)
-	{
-		Settings->ReleasedFolders.Remove(FolderPath);
-		Settings->UnreleasedFolders.AddUnique(FolderPath);
-		Settings->MixedFolders.Remove(FolderPath);
-	} else  if (NewPathState == Mixed)
-	{
-		Settings->ReleasedFolders.Remove(FolderPath);
-		Settings->UnreleasedFolders.Remove(FolderPath);
-		Settings->MixedFolders.AddUnique(FolderPath);
-	}
-	
-	// Update the Folder Color
-	UpdateColor(FolderPath, NewPathState);
-}
-
-void UOWIUnReleasedAssetsHandler::UpdateColor(const FString FolderPath, const EPathState PathState) const
-{
-	// Keeping this here in case Epic Games ever decides to make ContentBrowserUtils available
-	// If you really need this add CONTENTBROWSER_API in front of the function in the header file
-	// This will make it so the Color is immediately updated without having to restart the Editor
-	// You may then remove the lines below it as ContentBrowserUtils does basically the same thing
-	/*TSharedPtr<FLinearColor> Color;
-	switch (PathState)
-	{
-		case Unreleased:
-			{
-				Color = MakeShareable(new FLinearColor(Settings->UnreleasedFolderColor));
-				break;
-			}
-		case Mixed: 
-			{
-				Color = MakeShareable(new FLinearColor(Settings->MixedFolderColor));
-				break;
-			}
-		case Released:
-		case None:
-		default:
-			{
-				Color = nullptr;
-				break;
-			}
-	}
-	ContentBrowserUtils::SaveColor(FolderPath, Color, true);
-	*/
-	
-	if(FPaths::FileExists(GEditorPerProjectIni))
-	{
-		switch (PathState)
-		{
-		default:
-		case None:
-		case Released: 
-			GConfig->RemoveKey(TEXT("PathColor"), *FolderPath, GEditorPerProjectIni);
-			break;
-		case Unreleased:
-			GConfig->SetString(TEXT("PathColor"), *FolderPath, *Settings->UnreleasedFolderColor.ToString(), GEditorPerProjectIni);
-			break;
-		case Mixed:
-			GConfig->SetString(TEXT("PathColor"), *FolderPath, *Settings->MixedFolderColor.ToString(), GEditorPerProjectIni);
-			break;
-		}
-	}
-}
-
-void UOWIUnReleasedAssetsHandler::HandleSubfolderRelease(const FString CurrentFolderPath, const FString ReleaseFolderPath)
-{	
-	ReleaseFolder(CurrentFolderPath);
-	UpdateInternalConfig(CurrentFolderPath, Mixed);
-	// Check out all the folders within this folder
-	TArray<FString> Subfolders = GetSubfolders(CurrentFolderPath);
-	
-	for (auto& Subfolder : Subfolders)
-	{
-		if (ReleaseFolderPath.Equals(Subfolder))
-		{
-			continue;
-		}
-		
-		if (ReleaseFolderPath.StartsWith(Subfolder))
-		{
-			HandleSubfolderRelease(Subfolder, ReleaseFolderPath);
-		} else
-		{
-			UnreleaseFolder(Subfolder);
-		}
-	}
-}
-
-void UOWIUnReleasedAssetsHandler::UpdateParentFolder(const FString FolderPath, const bool bRelease)
-{
-	FString ParentFolder;
-	const bool bHasUnreleasedParent = Settings->UnreleasedFolders.ContainsByPredicate([&FolderPath, &ParentFolder](const auto& TempFolderPath)
-	{
-		if (FolderPath.StartsWith(TempFolderPath) && !FolderPath.Equals(TempFolderPath))
-		{
-			ParentFolder = TempFolderPath;
-			return true;
-		}
-		
-		return false;
-	});
-	
-	if (bRelease && bHasUnreleasedParent)
-	{
-		// A parent of this folder was unreleased
-		HandleSubfolderRelease(ParentFolder, FolderPath);
-	}
-	
-	const bool bHasMixedParent = Settings->MixedFolders.ContainsByPredicate([&FolderPath, &ParentFolder](const auto& TempFolderPath)
-    {
-        if (FolderPath.StartsWith(TempFolderPath) && !FolderPath.Equals(TempFolderPath))
-        {
-            ParentFolder = TempFolderPath;
-            return true;
-        }
-		
-        return false;
-    });
-
-	if (bHasMixedParent)
-	{
-		// Update the color of the parent folder
-		const TArray<FString> ChildFolders = GetSubfolders(ParentFolder);
-		const EPathState ChildState = GetFolderState(ChildFolders);
-		UpdateInternalConfig(ParentFolder, ChildState);
-	}
-}
-
-TArray<FString> UOWIUnReleasedAssetsHandler::GetSubfolders(const FString FolderPath)
-{
-	TArray<FString> Subfolders = UEditorAssetLibrary::ListAssets(FolderPath, false, true).FilterByPredicate([](const auto& FoundAssetName)
-        {
-            return !FoundAssetName.Contains(".");
-        });
-	for (auto& Subfolder : Subfolders)
-	{
-		Subfolder.RemoveFromEnd("/");
-	}
-	
-	return Subfolders;
-}
+// Copyright Offworld Industries
+
+#include "OWI_UnReleasedAssetsHandler.h"
+#include "Misc/ConfigCacheIni.h"
+#include "ContentBrowserModule.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "Editor/ContentBrowser/Private/ContentBrowserUtils.h"
+#include "Engine/EngineTypes.h"
+#include "Settings/ProjectPackagingSettings.h"
+#include "Runtime/AssetRegistry/Public/AssetRegistryModule.h"
+#include "Runtime/AssetRegistry/Public/IAssetRegistry.h"
+#include "Logging/TokenizedMessage.h"
+
+DEFINE_LOG_CATEGORY(LogUnReleasedAssetHandler);
+
+namespace OWIUnReleasedAssetsHandler
+{
+	// The section of the per project editor config the Content Browser reads the folder colors from
+	const TCHAR* PathColorSection = TEXT("PathColor");
+
+	const TCHAR* FolderColorHashSection = TEXT("OWI_EditorEnhancements");
+
+	const TCHAR* FolderColorHashKey = TEXT("FolderColorHash");
+
+	uint32 HashFolderColor(const FString& FolderPath, const FString& Color)
+	{
+		return HashCombine(FCrc::StrCrc32(*FolderPath.ToLower()), FCrc::StrCrc32(*Color));
+	}
+
+	// Independent of the order of the entries, it may change whenever the file is written
+	uint32 HashPathColorSection(const FConfigFile& ConfigFile)
+	{
+		uint32 Hash = 0;
+		if (const FConfigSection* Section = ConfigFile.Find(PathColorSection))
+		{
+			for (const auto& Entry : *Section)
+			{
+				Hash += HashFolderColor(Entry.Key.ToString(), Entry.Value.GetValue());
+			}
+		}
+		return Hash;
+	}
+}
+
+#if WITH_EDITOR
+void UOWIUnReleasedAssetsHandlerSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateFolderStates();
+}
+#endif
+
+void UOWIUnReleasedAssetsHandlerSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	InvalidateFolderStates();
+}
+
+FOWIFolderStateTree& UOWIUnReleasedAssetsHandlerSettings::GetFolderStates()
+{
+	if (bFolderStatesBuilt == false)
+	{
+		FolderStates.Build(UnreleasedFolders, ReleasedFolders, MixedFolders);
+		bFolderStatesBuilt = true;
+	}
+
+	return FolderStates;
+}
+
+void UOWIUnReleasedAssetsHandlerSettings::ApplyFolderStates()
+{
+	if (bFolderStatesBuilt)
+	{
+		FolderStates.Export(UnreleasedFolders, ReleasedFolders, MixedFolders);
+	}
+}
+
+void UOWIUnReleasedAssetsHandlerSettings::InvalidateFolderStates()
+{
+	bFolderStatesBuilt = false;
+}
+
+bool UOWIUnReleasedAssetsHandler::LoadSettings()
+{
+	Settings = GetMutableDefault<UOWIUnReleasedAssetsHandlerSettings>();
+	ReferenceRulesSettings = GetMutableDefault<UOWIReferenceRulesHandlerSettings>();
+	PackagingSettings = GetMutableDefault<UProjectPackagingSettings>();
+
+	if (Settings == nullptr || ReferenceRulesSettings == nullptr || PackagingSettings == nullptr)
+	{
+		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not read all settings!"));
+		return false;
+	}
+
+	return true;
+}
+
+void UOWIUnReleasedAssetsHandler::SaveSettings() const
+{
+	// The reference rules were changed directly, so they need to be compiled again
+	ReferenceRulesSettings->InvalidateCompiledRules();
+
+	// The folder states were only changed in the tree so far
+	Settings->ApplyFolderStates();
+	
+	Settings->UpdateDefaultConfigFile(Settings->GetDefaultConfigFilename());
+	ReferenceRulesSettings->UpdateDefaultConfigFile(ReferenceRulesSettings->GetDefaultConfigFilename());
+	PackagingSettings->UpdateDefaultConfigFile(PackagingSettings->GetDefaultConfigFilename());
+}
+
+bool UOWIUnReleasedAssetsHandler::BeginChanges()
+{
+	// The ModSDK file may have been edited since the last batch
+	bModSDKBlacklistLoaded = false;
+	bModSDKBlacklistValid = false;
+
+	return LoadSettings();
+}
+
+void UOWIUnReleasedAssetsHandler::EndChanges()
+{
+	if (bModSDKBlacklistValid)
+	{
+		SaveModSDKBlacklist();
+	}
+
+	// Save the Settings
+	SaveSettings();
+}
+
+void UOWIUnReleasedAssetsHandler::ReleaseFolder(const FString FolderPath)
+{
+	ReleaseFolders({ FolderPath });
+}
+
+void UOWIUnReleasedAssetsHandler::UnreleaseFolder(const FString FolderPath)
+{
+	UnreleaseFolders({ FolderPath });
+}
+
+void UOWIUnReleasedAssetsHandler::ReleaseFolders(const TArray<FString>& FolderPaths)
+{
+	if (!BeginChanges())
+	{
+		return;
+	}
+
+	for (const FString& FolderPath : FolderPaths)
+	{
+		ApplyRelease(FolderPath);
+	}
+
+	EndChanges();
+}
+
+void UOWIUnReleasedAssetsHandler::UnreleaseFolders(const TArray<FString>& FolderPaths)
+{
+	if (!BeginChanges())
+	{
+		return;
+	}
+
+	for (const FString& FolderPath : FolderPaths)
+	{
+		ApplyUnrelease(FolderPath);
+	}
+
+	EndChanges();
+}
+
+void UOWIUnReleasedAssetsHandler::ApplyRelease(const FString& FolderPath)
+{
+	// Remove Folder from reference rules
+	ReferenceRulesSettings->ReferenceRules.RemoveAll([&](const auto& Rule)
+    {
+        return Rule.AssetFolder.Path.Equals(Settings->AssetFolderToNotBeReferenced.Path)
+            && Rule.MayNotReferenceFolder.Path.Equals(FolderPath);
+    });
+
+	// Remove Folder from never cooking
+	PackagingSettings->DirectoriesToNeverCook.RemoveAll([&FolderPath](const auto& TempDirectoryPath)
+	{
+		return TempDirectoryPath.Path.Equals(FolderPath);
+	});
+	
+	// Remove Folder from Mod SDK Blacklist (Does this really need to be done? Not mentioned on Confluence page)
+	RemoveFolderFromModSDKBlacklist(GetModSDKCompatibleFolderName(FolderPath));	
+
+	// Update the internal config
+	UpdateInternalConfig(FolderPath, Released);
+	
+	// Also update the parent folder
+	UpdateParentFolder(FolderPath, true);
+}
+
+void UOWIUnReleasedAssetsHandler::ApplyUnrelease(const FString& FolderPath)
+{
+	const FDirectoryPath DirectoryPath = { FolderPath };
+	
+	// Add Folder to reference rules if not yet in there
+	const FOWIReferenceRule TempRule { Settings->AssetFolderToNotBeReferenced, DirectoryPath };
+	if (!ReferenceRulesSettings->ReferenceRules.ContainsByPredicate([&TempRule](const FOWIReferenceRule& TempInnerRule)
+        {
+            return TempRule.AssetFolder.Path.Equals(TempInnerRule.AssetFolder.Path)
+                && TempRule.MayNotReferenceFolder.Path.Equals(TempInnerRule.MayNotReferenceFolder.Path);
+        }))
+	{
+		ReferenceRulesSettings->ReferenceRules.Add(TempRule);
+	}
+	
+	// Add Folder to never cook if not yet in there
+	if (!PackagingSettings->DirectoriesToNeverCook.ContainsByPredicate([&DirectoryPath](const FDirectoryPath TempDirectoryPath)
+        {
+            return DirectoryPath.Path.Equals(TempDirectoryPath.Path);
+        }))
+	{
+		PackagingSettings->DirectoriesToNeverCook.Add(DirectoryPath);
+	}
+	
+	// Add Folder to Mod SDK Blacklist
+	AddFolderToModSDKBlacklist(GetModSDKCompatibleFolderName(FolderPath));
+
+	// Update the internal config
+	UpdateInternalConfig(FolderPath, Unreleased);
+
+	// Update the internal config
+	UpdateParentFolder(FolderPath, false);
+}
+
+void UOWIUnReleasedAssetsHandler::UpdateFolderColorsOnStart()
+{
+	using namespace OWIUnReleasedAssetsHandler;
+
+	if (!LoadSettings() || !FPaths::FileExists(GEditorPerProjectIni))
+	{
+		return;
+	}
+
+	FConfigFile* ConfigFile = GConfig->Find(GEditorPerProjectIni, false);
+	if (ConfigFile == nullptr)
+	{
+		return;
+	}
+
+	// Every tracked folder with the color it should have, released folders have no color
+	const FString UnreleasedColor = Settings->UnreleasedFolderColor.ToString();
+	const FString MixedColor = Settings->MixedFolderColor.ToString();
+	TArray<TPair<FString, FString>> FolderColors;
+	FolderColors.Reserve(Settings->UnreleasedFolders.Num() + Settings->ReleasedFolders.Num() + Settings->MixedFolders.Num());
+	for (auto& Path : Settings->UnreleasedFolders)
+	{
+		FolderColors.Emplace(Path, UnreleasedColor);
+	}
+
+	for (auto& Path : Settings->ReleasedFolders)
+	{
+		FolderColors.Emplace(Path, FString());
+	}
+
+	for (auto& Path : Settings->MixedFolders)
+	{
+		FolderColors.Emplace(Path, MixedColor);
+	}
+
+	uint32 FolderColorsHash = 0;
+	for (const auto& FolderColor : FolderColors)
+	{
+		FolderColorsHash += HashFolderColor(FolderColor.Key, FolderColor.Value);
+	}
+
+	// Nothing to do if these colors were applied before and the colors weren't changed since
+	FString StoredHash;
+	const FString CurrentHash = FString::Printf(TEXT("%08x"), HashCombine(FolderColorsHash, HashPathColorSection(*ConfigFile)));
+	if (GConfig->GetString(FolderColorHashSection, FolderColorHashKey, StoredHash, GEditorPerProjectIni) && StoredHash.Equals(CurrentHash))
+	{
+		return;
+	}
+
+	// Change the section directly instead of going through GConfig for every folder
+	FConfigSection* Section = ConfigFile->Find(PathColorSection);
+	if (Section == nullptr)
+	{
+		Section = &ConfigFile->Add(PathColorSection, FConfigSection());
+	}
+
+	bool bChanged = false;
+	for (const auto& FolderColor : FolderColors)
+	{
+		const FName Key(*FolderColor.Key);
+		if (FolderColor.Value.IsEmpty())
+		{
+			bChanged |= Section->Remove(Key) > 0;
+			continue;
+		}
+
+		const FConfigValue* ExistingValue = Section->Find(Key);
+		if (ExistingValue == nullptr || ExistingValue->GetValue().Equals(FolderColor.Value, ESearchCase::CaseSensitive) == false)
+		{
+			Section->Remove(Key);
+			Section->Add(Key, FConfigValue(FolderColor.Value));
+			bChanged = true;
+		}
+	}
+
+	// Written to disk together with every other change to the config file
+	if (bChanged)
+	{
+		ConfigFile->Dirty = true;
+	}
+
+	const FString AppliedHash = FString::Printf(TEXT("%08x"), HashCombine(FolderColorsHash, HashPathColorSection(*ConfigFile)));
+	GConfig->SetString(FolderColorHashSection, FolderColorHashKey, *AppliedHash, GEditorPerProjectIni);
+}
+
+EPathState UOWIUnReleasedAssetsHandler::GetFolderState(TArray<FString> Folders)
+{
+	EPathState PathState = None;
+	if (!LoadSettings())
+	{
+		return PathState;
+	}
+	
+	const FOWIFolderStateTree& FolderStates = Settings->GetFolderStates();
+	for (auto& Path : Folders)
+	{
+		if (FolderStates.IsUnreleased(Path))
+		{
+			if (PathState == None)
+			{
+				PathState = Unreleased;
+			} else if (PathState == Released)
+			{
+				PathState = Mixed;
+				break;
+			}  
+		} else
+		{
+			if (PathState == None)
+			{
+				PathState = Released;
+			} else if (PathState == Unreleased)
+			{
+				PathState = Mixed;
+				break;
+			}
+		}
+	}
+	
+	return PathState;
+}
+
+void UOWIUnReleasedAssetsHandler::AddFolderToModSDKBlacklist(const FString FolderPath)
+{
+	if (LoadModSDKBlacklist())
+	{
+		ModSDKBlacklist.Add(FolderPath);
+	}
+}
+
+void UOWIUnReleasedAssetsHandler::RemoveFolderFromModSDKBlacklist(const FString FolderPath)
+{
+	if (LoadModSDKBlacklist())
+	{
+		ModSDKBlacklist.Remove(FolderPath);
+	}
+}
+
+bool UOWIUnReleasedAssetsHandler::LoadModSDKBlacklist()
+{
+	// Read once per batch, every change is applied to the parsed blacklist
+	if (bModSDKBlacklistLoaded)
+	{
+		return bModSDKBlacklistValid;
+	}
+	bModSDKBlacklistLoaded = true;
+	
+	if (!FPaths::FileExists(Settings->ModSDKFile.FilePath))
+	{
+		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not find ModSDK file: %s!"), *Settings->ModSDKFile.FilePath);
+		return false;
+	}
+
+	if (!ModSDKBlacklist.Load(Settings->ModSDKFile.FilePath, Settings->ModSDKBlacklistStringStart))
+	{
+		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not read the blacklist \"%s\" from ModSDK file: %s!"), *Settings->ModSDKBlacklistStringStart, *Settings->ModSDKFile.FilePath);
+		return false;
+	}
+
+	bModSDKBlacklistValid = true;
+	return true;
+}
+
+void UOWIUnReleasedAssetsHandler::SaveModSDKBlacklist()
+{
+	if (!ModSDKBlacklist.Save())
+	{
+		UE_LOG(LogUnReleasedAssetHandler, Error, TEXT("Could not save ModSDK file: %s!"), *Settings->ModSDKFile.FilePath);
+	}
+}
+
+FString UOWIUnReleasedAssetsHandler::GetModSDKCompatibleFolderName(FString FolderPath)
+{
+	FolderPath.RemoveFromStart("/Game");
+	return FolderPath;
+}
+
+void UOWIUnReleasedAssetsHandler::UpdateInternalConfig(const FString FolderPath, const EPathState NewPathState) const
+{
+	if (NewPathState != None)
+	{
+		Settings->GetFolderStates().SetState(FolderPath, NewPathState);
+	}
+	
+	// Update the Folder Color
+	UpdateColor(FolderPath, NewPathState);
+}
+
+void UOWIUnReleasedAssetsHandler::UpdateColor(const FString FolderPath, const EPathState PathState) const
+{
+	// Keeping this here in case Epic Games ever decides to make ContentBrowserUtils available
+	// If you really need this add CONTENTBROWSER_API in front of the function in the header file
+	// This will make it so the Color is immediately updated without having to restart the Editor
+	// You may then remove the lines below it as ContentBrowserUtils does basically the same thing
+	/*TSharedPtr<FLinearColor> Color;
+	switch (PathState)
+	{
+		case Unreleased:
+			{
+				Color = MakeShareable(new FLinearColor(Settings->UnreleasedFolderColor));
+				break;
+			}
+		case Mixed: 
+			{
+				Color = MakeShareable(new FLinearColor(Settings->MixedFolderColor));
+				break;
+			}
+		case Released:
+		case None:
+		default:
+			{
+				Color = nullptr;
+				break;
+			}
+	}
+	ContentBrowserUtils::SaveColor(FolderPath, Color, true);
+	*/
+	
+	if(FPaths::FileExists(GEditorPerProjectIni))
+	{
+		switch (PathState)
+		{
+		default:
+		case None:
+		case Released: 
+			GConfig->RemoveKey(TEXT("PathColor"), *FolderPath, GEditorPerProjectIni);
+			break;
+		case Unreleased:
+			GConfig->SetString(TEXT("PathColor"), *FolderPath, *Settings->UnreleasedFolderColor.ToString(), GEditorPerProjectIni);
+			break;
+		case Mixed:
+			GConfig->SetString(TEXT("PathColor"), *FolderPath, *Settings->MixedFolderColor.ToString(), GEditorPerProjectIni);
+			break;
+		}
+	}
+}
+
+void UOWIUnReleasedAssetsHandler::HandleSubfolderRelease(const FString CurrentFolderPath, const FString ReleaseFolderPath)
+{	
+	ApplyRelease(CurrentFolderPath);
+	UpdateInternalConfig(CurrentFolderPath, Mixed);
+	// Check out all the folders within this folder
+	TArray<FString> Subfolders = GetSubfolders(CurrentFolderPath);
+	
+	for (auto& Subfolder : Subfolders)
+	{
+		if (ReleaseFolderPath.Equals(Subfolder))
+		{
+			continue;
+		}
+		
+		if (ReleaseFolderPath.StartsWith(Subfolder))
+		{
+			HandleSubfolderRelease(Subfolder, ReleaseFolderPath);
+		} else
+		{
+			ApplyUnrelease(Subfolder);
+		}
+	}
+}
+
+void UOWIUnReleasedAssetsHandler::UpdateParentFolder(const FString FolderPath, const bool bRelease)
+{
+	TArray<FString> ParentFolders;
+	Settings->GetFolderStates().GetTrackedAncestors(FolderPath, Unreleased, ParentFolders);
+	
+	if (bRelease && ParentFolders.Num() > 0)
+	{
+		// A parent of this folder was unreleased, the outermost one has to be split up down to this folder
+		HandleSubfolderRelease(ParentFolders.Last(), FolderPath);
+	}
+
+	// The releases above may have changed the states, so the mixed parents are looked up afterwards
+	Settings->GetFolderStates().GetTrackedAncestors(FolderPath, Mixed, ParentFolders);
+
+	// Nearest first, so every parent sees the updated state of the ones within it
+	for (const FString& ParentFolder : ParentFolders)
+	{
+		if (Settings->GetFolderStates().HasTrackedDescendants(ParentFolder, Unreleased) == false)
+		{
+			// Nothing within is unreleased anymore, no need to look at the subfolders
+			UpdateInternalConfig(ParentFolder, Released);
+			continue;
+		}
+
+		// Update the color of the parent folder
+		const TArray<FString> ChildFolders = GetSubfolders(ParentFolder);
+		const EPathState ChildState = GetFolderState(ChildFolders);
+		UpdateInternalConfig(ParentFolder, ChildState);
+	}
+}
+
+TArray<FString> UOWIUnReleasedAssetsHandler::GetSubfolders(const FString FolderPath)
+{
+	// The Asset Registry keeps a tree of all content paths, so this doesn't depend on the number of Assets in the folder
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	TArray<FString> Subfolders;
+	AssetRegistry.GetSubPaths(FolderPath, Subfolders, false);
+	
+	return Subfolders;
+}
@@ -0,0 +1,375 @@
+// Copyright Offworld Industries
+
+#include "OWI_ValidateCommandlet.h"
+#include "AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_PackageChangeListener.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "OWI_ValidationStats.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY(LogOWIValidateCommandlet);
+
+namespace OWIValidateCommandlet
+{
+	// Loaded Assets are released every so often to keep the memory in check
+	constexpr int32 GarbageCollectionInterval = 256;
+
+	FString EscapeXml(const FString& Text)
+	{
+		return Text.Replace(TEXT("&"), TEXT("&amp;"))
+			.Replace(TEXT("<"), TEXT("&lt;"))
+			.Replace(TEXT(">"), TEXT("&gt;"))
+			.Replace(TEXT("\""), TEXT("&quot;"))
+			.Replace(TEXT("'"), TEXT("&apos;"))
+			.Replace(TEXT("\n"), TEXT("&#10;"));
+	}
+
+	// Roots may overlap, so every package and Asset is only gathered once
+	void GetAssetsByPackage(const IAssetRegistry& AssetRegistry, const TArray<FString>& Roots, TMap<FName, TArray<FAssetData>>& OutAssetsByPackage)
+	{
+		OutAssetsByPackage.Reset();
+		for (const FString& Root : Roots)
+		{
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPath(*Root, Assets, true);
+
+			for (FAssetData& AssetData : Assets)
+			{
+				OutAssetsByPackage.FindOrAdd(AssetData.PackageName).AddUnique(MoveTemp(AssetData));
+			}
+		}
+	}
+}
+
+UOWIValidateCommandlet::UOWIValidateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Validates reference rules and naming conventions and writes the results as JSON and JUnit");
+	HelpUsage = TEXT("-run=OWIValidate [-Roots=/Game+/Game/Other] [-Json=Path] [-JUnit=Path] [-SkipReferenceRules] [-SkipNamingConventions] [-Incremental]");
+}
+
+int32 UOWIValidateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	TArray<FString> Roots;
+	if (const FString* RootsParam = ParamsMap.Find(TEXT("Roots")))
+	{
+		RootsParam->ParseIntoArray(Roots, TEXT("+"));
+	}
+	if (Roots.Num() == 0)
+	{
+		Roots.Add(TEXT("/Game"));
+	}
+
+	const FString JsonPath = ParamsMap.Contains(TEXT("Json"))
+		? ParamsMap[TEXT("Json")]
+		: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OWI_EditorEnhancements"), TEXT("ValidationResults.json"));
+	const FString JUnitPath = ParamsMap.FindRef(TEXT("JUnit"));
+
+	// Everything is checked from the Asset Registry, so it needs to know about all Assets first
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FOWIValidationStats::Get().Reset();
+
+	ReferenceRulesHandler = NewObject<UOWIReferenceRulesHandler>(this);
+	NamingConventionHandler = NewObject<UOWINamingConventionHandler>(this);
+
+	bIncremental = Switches.Contains(TEXT("Incremental"));
+	if (bIncremental)
+	{
+		ValidationCache.Load();
+		ValidationCache.UpdateSettingsHash();
+	}
+
+	TArray<FOWIValidateCommandletResult> Results;
+
+	if (Switches.Contains(TEXT("SkipReferenceRules")) == false)
+	{
+		ValidateReferenceRules(Roots, Results.AddDefaulted_GetRef());
+	}
+
+	if (Switches.Contains(TEXT("SkipNamingConventions")) == false)
+	{
+		ValidateNamingConventions(Roots, Results.AddDefaulted_GetRef());
+	}
+
+	int32 NumViolations = 0;
+	for (const FOWIValidateCommandletResult& Result : Results)
+	{
+		UE_LOG(LogOWIValidateCommandlet, Display, TEXT("%s: %d packages checked, %d violations, %.2f seconds"),
+			*Result.CheckName, Result.CheckedPackages.Num(), Result.Violations.Num(), Result.Seconds);
+
+		for (const FOWIValidateCommandletViolation& Violation : Result.Violations)
+		{
+			UE_LOG(LogOWIValidateCommandlet, Error, TEXT("%s"), *Violation.Message);
+		}
+		NumViolations += Result.Violations.Num();
+	}
+
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::Violations, NumViolations);
+	FOWIValidationStats::Get().LogSummary(TEXT("OWIValidate"));
+
+	if (bIncremental && ValidationCache.Save() == false)
+	{
+		UE_LOG(LogOWIValidateCommandlet, Warning, TEXT("Could not save the validation cache!"));
+	}
+
+	if (WriteJson(JsonPath, Roots, Results) == false)
+	{
+		UE_LOG(LogOWIValidateCommandlet, Error, TEXT("Could not write JSON results: %s!"), *JsonPath);
+	}
+
+	if (JUnitPath.IsEmpty() == false && WriteJUnit(JUnitPath, Results) == false)
+	{
+		UE_LOG(LogOWIValidateCommandlet, Error, TEXT("Could not write JUnit results: %s!"), *JUnitPath);
+	}
+
+	return NumViolations > 0 ? 1 : 0;
+}
+
+void UOWIValidateCommandlet::ValidateReferenceRules(const TArray<FString>& Roots, FOWIValidateCommandletResult& OutResult)
+{
+	OutResult.CheckName = TEXT("ReferenceRules");
+	const double StartTime = FPlatformTime::Seconds();
+
+	ReferenceRulesHandler->ResetCaches();
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	TMap<FName, TArray<FAssetData>> AssetsByPackage;
+	OWIValidateCommandlet::GetAssetsByPackage(AssetRegistry, Roots, AssetsByPackage);
+
+	TArray<FName> PackageNames;
+	for (const TPair<FName, TArray<FAssetData>>& Package : AssetsByPackage)
+	{
+		if (ReferenceRulesHandler->RuleCanBeApplied(Package.Key.ToString()))
+		{
+			PackageNames.Add(Package.Key);
+		}
+	}
+	OutResult.CheckedPackages.Append(PackageNames);
+
+	TArray<FName> ChangedPackageNames;
+	for (const FName& PackageName : PackageNames)
+	{
+		if (AddCachedResult(PackageName, EOWIValidationCheck::ReferenceRules, OutResult) == false)
+		{
+			ChangedPackageNames.Add(PackageName);
+		}
+	}
+
+	// Every violation of a package becomes its own entry, the cache keeps them as one text per package
+	FOWIReferenceViolations Violations;
+	ReferenceRulesHandler->ValidatePackages(ChangedPackageNames, Violations, EOWIReferenceCheckScope::Local);
+	TMap<FName, FString> ValidationErrors;
+	for (int32 ViolationIndex = 0; ViolationIndex < Violations.Num(); ++ViolationIndex)
+	{
+		const FName PackageName = Violations.Violations[ViolationIndex].PackageName;
+		FString Message = Violations.ToString(ViolationIndex, *ReferenceRulesHandler->GetSettings());
+		if (bIncremental)
+		{
+			FString& ValidationError = ValidationErrors.FindOrAdd(PackageName);
+			ValidationError.Append(ValidationError.IsEmpty() ? TEXT("") : LINE_TERMINATOR).Append(Message);
+		}
+
+		OutResult.Violations.Add({ PackageName, MoveTemp(Message) });
+	}
+
+	if (bIncremental)
+	{
+		for (const FName& PackageName : ChangedPackageNames)
+		{
+			ValidationCache.Add(PackageName, FOWIPackageChangeListener::GetPackageGuid(PackageName), EOWIValidationCheck::ReferenceRules, ValidationErrors.FindRef(PackageName));
+		}
+	}
+
+	// Circular and transitive dependencies change with any reachable package, so every package is checked, also with -Incremental
+	FOWIReferenceViolations GraphViolations;
+	ReferenceRulesHandler->ValidatePackages(PackageNames, GraphViolations, EOWIReferenceCheckScope::Graph);
+	for (int32 ViolationIndex = 0; ViolationIndex < GraphViolations.Num(); ++ViolationIndex)
+	{
+		OutResult.Violations.Add({ GraphViolations.Violations[ViolationIndex].PackageName, GraphViolations.ToString(ViolationIndex, *ReferenceRulesHandler->GetSettings()) });
+	}
+
+	ReferenceRulesHandler->ResetCaches();
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void UOWIValidateCommandlet::ValidateNamingConventions(const TArray<FString>& Roots, FOWIValidateCommandletResult& OutResult)
+{
+	OutResult.CheckName = TEXT("NamingConventions");
+	const double StartTime = FPlatformTime::Seconds();
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	const UOWINamingConventionHandlerSettings* Settings = GetDefault<UOWINamingConventionHandlerSettings>();
+	TMap<FName, TArray<FAssetData>> AssetsByPackage;
+	OWIValidateCommandlet::GetAssetsByPackage(AssetRegistry, Roots, AssetsByPackage);
+
+	int32 NumLoaded = 0;
+	for (TPair<FName, TArray<FAssetData>>& Package : AssetsByPackage)
+	{
+		const FName PackageName = Package.Key;
+		Package.Value.RemoveAll([Settings](const FAssetData& AssetData)
+		{
+			return AssetData.IsRedirector() || Settings->bEnabled == false || Settings->IsInCheckedFolder(AssetData.ObjectPath.ToString()) == false;
+		});
+
+		const bool bCacheable = Package.Value.ContainsByPredicate([](const FAssetData& AssetData)
+		{
+			return FOWIValidationCache::IsCacheable(AssetData.GetClass(), EOWIValidationCheck::NamingConventions) == false;
+		}) == false;
+
+		// Unchanged packages don't even need to be loaded
+		if (Package.Value.Num() == 0 || (bCacheable && AddCachedResult(PackageName, EOWIValidationCheck::NamingConventions, OutResult)))
+		{
+			continue;
+		}
+
+		OutResult.CheckedPackages.Add(PackageName);
+
+		// The cache keeps one text per package, so the results of all its Assets are combined first
+		FString PackageValidationError;
+		for (const FAssetData& AssetData : Package.Value)
+		{
+			// Most Assets are decided from their Asset Registry data, only a few classes need to be loaded
+			const bool bWasLoaded = AssetData.IsAssetLoaded();
+			FString ValidationError;
+			NamingConventionHandler->NamingConventionIsViolated(AssetData, ValidationError);
+			if (ValidationError.IsEmpty() == false)
+			{
+				PackageValidationError.Append(PackageValidationError.IsEmpty() ? TEXT("") : LINE_TERMINATOR).Append(ValidationError);
+				OutResult.Violations.Add({ PackageName, MoveTemp(ValidationError) });
+			}
+
+			if (bWasLoaded == false && AssetData.IsAssetLoaded() && ++NumLoaded % OWIValidateCommandlet::GarbageCollectionInterval == 0)
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+		}
+
+		if (bIncremental && bCacheable)
+		{
+			ValidationCache.Add(PackageName, FOWIPackageChangeListener::GetPackageGuid(PackageName), EOWIValidationCheck::NamingConventions, PackageValidationError);
+		}
+	}
+
+	UE_LOG(LogOWIValidateCommandlet, Display, TEXT("NamingConventions: %d Assets had to be loaded"), NumLoaded);
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+bool UOWIValidateCommandlet::AddCachedResult(const FName PackageName, const EOWIValidationCheck Check, FOWIValidateCommandletResult& OutResult) const
+{
+	if (bIncremental == false)
+	{
+		return false;
+	}
+
+	FString ValidationError;
+	if (ValidationCache.Find(PackageName, FOWIPackageChangeListener::GetPackageGuid(PackageName), Check, ValidationError) == false)
+	{
+		FOWIValidationStats::Get().Add(EOWIValidationCounter::ValidationCacheMisses);
+		return false;
+	}
+	FOWIValidationStats::Get().Add(EOWIValidationCounter::ValidationCacheHits);
+
+	if (Check == EOWIValidationCheck::NamingConventions)
+	{
+		OutResult.CheckedPackages.Add(PackageName);
+	}
+
+	// A package may have more than one violation, one per line
+	TArray<FString> Messages;
+	ValidationError.ParseIntoArrayLines(Messages);
+	for (FString& Message : Messages)
+	{
+		OutResult.Violations.Add({ PackageName, MoveTemp(Message) });
+	}
+	return true;
+}
+
+bool UOWIValidateCommandlet::WriteJson(const FString& FilePath, const TArray<FString>& Roots, const TArray<FOWIValidateCommandletResult>& Results)
+{
+	FString Output;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Output);
+
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("roots"));
+	for (const FString& Root : Roots)
+	{
+		Writer->WriteValue(Root);
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteArrayStart(TEXT("checks"));
+	for (const FOWIValidateCommandletResult& Result : Results)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Result.CheckName);
+		Writer->WriteValue(TEXT("seconds"), Result.Seconds);
+		Writer->WriteValue(TEXT("checked"), Result.CheckedPackages.Num());
+		Writer->WriteArrayStart(TEXT("violations"));
+		for (const FOWIValidateCommandletViolation& Violation : Result.Violations)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("package"), Violation.PackageName.ToString());
+			Writer->WriteValue(TEXT("message"), Violation.Message);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Output, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool UOWIValidateCommandlet::WriteJUnit(const FString& FilePath, const TArray<FOWIValidateCommandletResult>& Results)
+{
+	FString Output = TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+
+	for (const FOWIValidateCommandletResult& Result : Results)
+	{
+		// A test case only has a single failure, so all violations of a package are joined
+		TMap<FName, FString> MessagesByPackage;
+		for (const FOWIValidateCommandletViolation& Violation : Result.Violations)
+		{
+			FString& Message = MessagesByPackage.FindOrAdd(Violation.PackageName);
+			Message.Append(Message.IsEmpty() ? TEXT("") : TEXT("\n")).Append(Violation.Message);
+		}
+
+		Output += FString::Printf(TEXT("\t<testsuite name=\"%s\" tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"),
+			*Result.CheckName, Result.CheckedPackages.Num(), MessagesByPackage.Num(), Result.Seconds);
+
+		for (const FName& PackageName : Result.CheckedPackages)
+		{
+			const FString EscapedName = OWIValidateCommandlet::EscapeXml(PackageName.ToString());
+			const FString* Message = MessagesByPackage.Find(PackageName);
+			if (Message == nullptr)
+			{
+				Output += FString::Printf(TEXT("\t\t<testcase classname=\"%s\" name=\"%s\"/>\n"), *Result.CheckName, *EscapedName);
+				continue;
+			}
+
+			Output += FString::Printf(TEXT("\t\t<testcase classname=\"%s\" name=\"%s\">\n\t\t\t<failure message=\"%s\"/>\n\t\t</testcase>\n"),
+				*Result.CheckName, *EscapedName, *OWIValidateCommandlet::EscapeXml(*Message));
+		}
+
+		Output += TEXT("\t</testsuite>\n");
+	}
+
+	Output += TEXT("</testsuites>\n");
+	return FFileHelper::SaveStringToFile(Output, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
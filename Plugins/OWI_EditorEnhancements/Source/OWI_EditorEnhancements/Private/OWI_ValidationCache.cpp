@@ -0,0 +1,199 @@
+// Copyright Offworld Industries
+
+#include "OWI_ValidationCache.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OWI_NamingConventionHandler.h"
+#include "OWI_ReferenceRulesHandler.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace OWIValidationCache
+{
+	// Bump whenever the file layout or the meaning of a result changes
+	constexpr int32 FileVersion = 1;
+
+	uint32 HashConfigProperties(const UObject* Settings, const uint32 Crc)
+	{
+		uint32 Hash = Crc;
+		for (TFieldIterator<FProperty> It(Settings->GetClass()); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_Config))
+			{
+				FString Value;
+				It->ExportTextItem(Value, It->ContainerPtrToValuePtr<void>(Settings), nullptr, nullptr, PPF_None);
+				Hash = FCrc::StrCrc32(*Value, Hash);
+			}
+		}
+		return Hash;
+	}
+}
+
+void FOWIValidationCache::Initialize()
+{
+	Load();
+	UpdateSettingsHash();
+
+	PackageChangeListener.Start([this](const FName PackageName)
+	{
+		Invalidate(PackageName);
+	}, true);
+}
+
+void FOWIValidationCache::Shutdown()
+{
+	PackageChangeListener.Stop();
+
+	if (bDirty)
+	{
+		Save();
+	}
+}
+
+void FOWIValidationCache::UpdateSettingsHash()
+{
+	SettingsHash = ComputeSettingsHash();
+}
+
+bool FOWIValidationCache::Find(const FName PackageName, const FGuid& PackageGuid, const EOWIValidationCheck Check, FString& OutValidationError) const
+{
+	const FEntry* Entry = Entries.Find(PackageName);
+	if (Entry == nullptr
+		|| PackageGuid.IsValid() == false
+		|| Entry->PackageGuid != PackageGuid
+		|| Entry->SettingsHash != SettingsHash
+		|| (Entry->CheckedMask & (1 << static_cast<uint8>(Check))) == 0)
+	{
+		return false;
+	}
+
+	OutValidationError = Entry->ValidationErrors[static_cast<int32>(Check)];
+	return true;
+}
+
+void FOWIValidationCache::Add(const FName PackageName, const FGuid& PackageGuid, const EOWIValidationCheck Check, const FString& ValidationError)
+{
+	if (PackageGuid.IsValid() == false)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(PackageName);
+	if (Entry.PackageGuid != PackageGuid || Entry.SettingsHash != SettingsHash)
+	{
+		// Results of an older state of the package don't belong together with the new one
+		Entry = FEntry();
+		Entry.PackageGuid = PackageGuid;
+		Entry.SettingsHash = SettingsHash;
+	}
+
+	Entry.CheckedMask |= 1 << static_cast<uint8>(Check);
+	Entry.ValidationErrors[static_cast<int32>(Check)] = ValidationError;
+	bDirty = true;
+}
+
+void FOWIValidationCache::Invalidate(const FName PackageName)
+{
+	bDirty |= Entries.Remove(PackageName) > 0;
+
+	// Referencers are checked against this package, e.g. its folder, so they need to be checked again as well
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+	for (const FName& Referencer : Referencers)
+	{
+		bDirty |= Entries.Remove(Referencer) > 0;
+	}
+}
+
+bool FOWIValidationCache::IsCacheable(const UClass* AssetClass, const EOWIValidationCheck Check)
+{
+	if (Check != EOWIValidationCheck::NamingConventions)
+	{
+		return true;
+	}
+
+	// Without the class there is no telling what the result depends on
+	return AssetClass != nullptr && AssetClass->IsChildOf<UMaterialInterface>() == false && AssetClass->IsChildOf<UBlueprint>() == false;
+}
+
+bool FOWIValidationCache::Load()
+{
+	Entries.Reset();
+	bDirty = false;
+
+	TArray<uint8> Data;
+	if (FFileHelper::LoadFileToArray(Data, *GetCacheFilePath(), FILEREAD_Silent) == false)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	int32 Version = 0;
+	Reader << Version;
+	if (Version != OWIValidationCache::FileVersion)
+	{
+		return false;
+	}
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+	Entries.Reserve(NumEntries);
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries && Reader.IsError() == false; ++EntryIndex)
+	{
+		FString PackageName;
+		FEntry Entry;
+		Reader << PackageName << Entry.PackageGuid << Entry.SettingsHash << Entry.CheckedMask;
+		for (FString& ValidationError : Entry.ValidationErrors)
+		{
+			Reader << ValidationError;
+		}
+		Entries.Add(FName(*PackageName), MoveTemp(Entry));
+	}
+
+	if (Reader.IsError())
+	{
+		Entries.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FOWIValidationCache::Save() const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	int32 Version = OWIValidationCache::FileVersion;
+	int32 NumEntries = Entries.Num();
+	Writer << Version << NumEntries;
+	for (const TPair<FName, FEntry>& Pair : Entries)
+	{
+		FString PackageName = Pair.Key.ToString();
+		FEntry Entry = Pair.Value;
+		Writer << PackageName << Entry.PackageGuid << Entry.SettingsHash << Entry.CheckedMask;
+		for (FString& ValidationError : Entry.ValidationErrors)
+		{
+			Writer << ValidationError;
+		}
+	}
+
+	return FFileHelper::SaveArrayToFile(Data, *GetCacheFilePath());
+}
+
+FString FOWIValidationCache::GetCacheFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OWI_EditorEnhancements"), TEXT("ValidationCache.bin"));
+}
+
+uint32 FOWIValidationCache::ComputeSettingsHash()
+{
+	uint32 Hash = OWIValidationCache::FileVersion;
+	Hash = OWIValidationCache::HashConfigProperties(GetDefault<UOWIReferenceRulesHandlerSettings>(), Hash);
+	Hash = OWIValidationCache::HashConfigProperties(GetDefault<UOWINamingConventionHandlerSettings>(), Hash);
+	return Hash;
+}
@@ -0,0 +1,92 @@
+// Copyright Offworld Industries
+
+#include "OWI_ValidationStats.h"
+
+DEFINE_LOG_CATEGORY(LogOWIValidation);
+
+DEFINE_STAT(STAT_OWI_ValidateAsset);
+DEFINE_STAT(STAT_OWI_GatherDependencies);
+DEFINE_STAT(STAT_OWI_ReferenceRules);
+DEFINE_STAT(STAT_OWI_CircularDependencies);
+DEFINE_STAT(STAT_OWI_TransitiveReferences);
+DEFINE_STAT(STAT_OWI_NamingConventions);
+
+namespace OWIValidationStats
+{
+	const TCHAR* TimerNames[] =
+	{
+		TEXT("ValidateAsset"),
+		TEXT("GatherDependencies"),
+		TEXT("ReferenceRules"),
+		TEXT("CircularDependencies"),
+		TEXT("TransitiveReferences"),
+		TEXT("NamingConventions")
+	};
+	static_assert(UE_ARRAY_COUNT(TimerNames) == static_cast<int32>(EOWIValidationTimer::Num), "Every timer needs a name");
+
+	const TCHAR* CounterNames[] =
+	{
+		TEXT("ReferenceRulesChecked"),
+		TEXT("NamingConventionsChecked"),
+		TEXT("RegistryQueries"),
+		TEXT("RulesEvaluated"),
+		TEXT("ValidationCacheHits"),
+		TEXT("ValidationCacheMisses"),
+		TEXT("ClassCacheHits"),
+		TEXT("DependencyGraphHits"),
+		TEXT("Violations")
+	};
+	static_assert(UE_ARRAY_COUNT(CounterNames) == static_cast<int32>(EOWIValidationCounter::Num), "Every counter needs a name");
+}
+
+FOWIValidationStats& FOWIValidationStats::Get()
+{
+	static FOWIValidationStats Stats;
+	return Stats;
+}
+
+void FOWIValidationStats::Add(const EOWIValidationCounter Counter, const int64 Value)
+{
+	Counters[static_cast<int32>(Counter)] += Value;
+}
+
+void FOWIValidationStats::AddCycles(const EOWIValidationTimer Timer, const uint64 InCycles)
+{
+	Cycles[static_cast<int32>(Timer)] += InCycles;
+}
+
+void FOWIValidationStats::Reset()
+{
+	for (TAtomic<int64>& Counter : Counters)
+	{
+		Counter = 0;
+	}
+
+	for (TAtomic<uint64>& TimerCycles : Cycles)
+	{
+		TimerCycles = 0;
+	}
+}
+
+void FOWIValidationStats::LogSummary(const TCHAR* BatchName) const
+{
+	if (Counters[static_cast<int32>(EOWIValidationCounter::ReferenceRulesChecked)] == 0
+		&& Counters[static_cast<int32>(EOWIValidationCounter::NamingConventionsChecked)] == 0)
+	{
+		return;
+	}
+
+	// Time spent on worker threads is summed up, so timers may add up to more than the wall time
+	FString Summary = FString::Printf(TEXT("%s:"), BatchName);
+	for (int32 TimerIndex = 0; TimerIndex < static_cast<int32>(EOWIValidationTimer::Num); ++TimerIndex)
+	{
+		Summary += FString::Printf(TEXT(" %s=%.2fms"), OWIValidationStats::TimerNames[TimerIndex], FPlatformTime::ToMilliseconds64(Cycles[TimerIndex]));
+	}
+
+	for (int32 CounterIndex = 0; CounterIndex < static_cast<int32>(EOWIValidationCounter::Num); ++CounterIndex)
+	{
+		Summary += FString::Printf(TEXT(" %s=%lld"), OWIValidationStats::CounterNames[CounterIndex], Counters[CounterIndex].Load());
+	}
+
+	UE_LOG(LogOWIValidation, Log, TEXT("%s"), *Summary);
+}
@@ -0,0 +1,93 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OWI_BenchmarkCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOWIBenchmarkCommandlet, Log, All);
+
+struct FDirectoryPath;
+struct FOWIReferenceRule;
+
+/** A synthetic content tree with a dependency graph, only names, nothing exists on disk */
+struct FOWIBenchmarkGraph
+{
+	TArray<FName> PackageNames;
+
+	// The same names as strings, the rules take Asset paths as FString
+	TArray<FString> PackagePaths;
+
+	TArray<TArray<FName>> Dependencies;
+};
+
+/** The measurement of one benchmark on one graph size */
+struct FOWIBenchmarkResult
+{
+	FString Name;
+
+	int32 NumNodes = 0;
+
+	int64 Operations = 0;
+
+	double Seconds = 0.0;
+
+	int64 Allocations = 0;
+};
+
+/**
+ * Times the validation hot paths on synthetic dependency graphs, e.g. to compare changes on a build agent:
+ * UE4Editor-Cmd Project.uproject -run=OWIBenchmark -Nodes=10000+100000 -Rules=32 -Exceptions=4 -CycleEvery=1000 -Json=Results.json
+ * Reports operations per second and heap allocations per operation for every benchmark and graph size.
+ */
+UCLASS()
+class OWI_EDITORENHANCEMENTS_API UOWIBenchmarkCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWIBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+
+	/**
+	 * \brief Build a content tree of chains and diamonds with random extra dependencies
+	 * \param NumNodes The number of packages
+	 * \param NumFolders The number of top level folders the packages are spread over
+	 * \param CycleEvery Add a dependency back to an earlier package every so many packages, 0 for none
+	 * \param OutGraph The graph to fill
+	 */
+	static void BuildGraph(int32 NumNodes, int32 NumFolders, int32 CycleEvery, FOWIBenchmarkGraph& OutGraph);
+
+	/**
+	 * \brief Build rules where every folder may not reference the next one, with exceptions for some subfolders
+	 * \param NumRules The number of rules
+	 * \param NumExceptions The number of exception folders per rule
+	 * \param OutRules The rules to fill
+	 * \param OutBlackList The BlackList to fill, one entry per rule
+	 */
+	static void BuildRules(int32 NumRules, int32 NumExceptions, TArray<FOWIReferenceRule>& OutRules, TArray<FDirectoryPath>& OutBlackList);
+
+	/**
+	 * \brief Run a benchmark and measure it
+	 * \param Name The name of the benchmark
+	 * \param NumNodes The size of the graph the benchmark runs on
+	 * \param Benchmark Runs the benchmark and returns the number of operations done
+	 * \return The measurement
+	 */
+	static FOWIBenchmarkResult Measure(const FString& Name, int32 NumNodes, TFunctionRef<int64()> Benchmark);
+
+	/**
+	 * \brief Write the measurements as a JSON array
+	 * \param FilePath The file to write
+	 * \param Results The measurements to write
+	 * \return False if the file couldn't be written
+	 */
+	static bool WriteJson(const FString& FilePath, const TArray<FOWIBenchmarkResult>& Results);
+};
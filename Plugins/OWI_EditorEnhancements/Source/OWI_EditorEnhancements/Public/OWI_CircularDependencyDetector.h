@@ -0,0 +1,54 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_StronglyConnectedComponents.h"
+
+/**
+ * Finds circular dependencies by computing the strongly connected components of a dependency graph.
+ * The graph is explored lazily starting at the queried packages and every package is only visited once,
+ * so later queries for packages that were already reached are a simple lookup until Reset is called.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWICircularDependencyDetector
+{
+
+public:
+
+	// Fills the dependencies of the given package that should be part of the graph
+	typedef FOWIStronglyConnectedComponents::FGetDependencies FGetDependencies;
+
+	/**
+	 * \brief Forget the explored graph, e.g. because dependencies changed
+	 */
+	void Reset();
+
+	/**
+	 * \brief Is the package part of a dependency cycle?
+	 * \param PackageName The package to check
+	 * \param GetDependencies Provides the dependencies of packages not explored yet
+	 * \param OutCyclePath The packages of one cycle, starting and ending with the given package
+	 * \return True if the package depends on itself through at least one other package
+	 */
+	bool FindCycle(FName PackageName, FGetDependencies GetDependencies, TArray<FName>& OutCyclePath);
+
+	/**
+	 * \brief How many packages have been explored so far?
+	 * \return The number of nodes in the graph
+	 */
+	int32 Num() const;
+
+private:
+
+	FOWIStronglyConnectedComponents Components;
+
+	// Number of nodes in each strongly connected component
+	TArray<int32> ComponentSizes;
+
+	/**
+	 * \brief Find the shortest cycle through the start node within its component
+	 * \param StartNode The node the cycle has to go through
+	 * \param OutCyclePath The package names along the cycle
+	 */
+	void BuildCyclePath(int32 StartNode, TArray<FName>& OutCyclePath) const;
+};
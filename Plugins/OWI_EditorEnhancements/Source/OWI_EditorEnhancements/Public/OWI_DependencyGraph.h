@@ -0,0 +1,158 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_PackageChangeListener.h"
+
+struct FOWIPackageDependencies;
+class IAssetRegistry;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * The package dependencies needed by the reference rules, persisted in the Saved folder between sessions.
+ * The snapshot is stored in compressed sparse row form (an offset per package into one array of package indices)
+ * and memory mapped, so nothing but the package names has to be read when the Editor starts. Packages changed since
+ * are fetched from the Asset Registry into an overlay, which is merged into the snapshot when saving.
+ * A package is only taken from the snapshot as long as its package guid matches the one of the saved package.
+ * Only to be used from the game thread.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIDependencyGraph
+{
+
+public:
+
+	~FOWIDependencyGraph();
+
+	/**
+	 * \brief Map the persisted snapshot and start listening to Asset Registry changes
+	 */
+	void Initialize();
+
+	/**
+	 * \brief Stop listening to Asset Registry changes and persist the graph if anything was added
+	 */
+	void Shutdown();
+
+	/**
+	 * \brief Get the hard and soft dependencies of a package, only asks the Asset Registry if they aren't known yet
+	 * \param PackageName The package to get the dependencies for
+	 * \param AssetRegistry The Asset Registry to use for unknown or changed packages
+	 * \param OutDependencies The dependencies of the package
+	 */
+	void GetDependencies(FName PackageName, const IAssetRegistry& AssetRegistry, FOWIPackageDependencies& OutDependencies);
+
+	/**
+	 * \brief Get the hard dependencies of a package, only asks the Asset Registry if they aren't known yet
+	 * \param PackageName The package to get the dependencies for
+	 * \param AssetRegistry The Asset Registry to use for unknown or changed packages
+	 * \param OutDependencies The array to add the dependencies to
+	 */
+	void GetHardDependencies(FName PackageName, const IAssetRegistry& AssetRegistry, TArray<FName>& OutDependencies);
+
+	/**
+	 * \brief Forget the dependencies of a package, they are fetched again on next use
+	 * \param PackageName The package that changed
+	 */
+	void Invalidate(FName PackageName);
+
+	/**
+	 * \brief How many packages have their dependencies stored?
+	 * \return The number of packages in the snapshot and the overlay
+	 */
+	int32 Num() const;
+
+	bool Load();
+
+	bool Save();
+
+private:
+
+	struct FFileHeader
+	{
+		uint32 Magic = 0;
+
+		uint32 Version = 0;
+
+		uint32 NumPackages = 0;
+
+		uint32 NumEdges = 0;
+
+		uint32 NamesSize = 0;
+	};
+
+	struct FOverlayEntry
+	{
+		FGuid PackageGuid;
+
+		// The hard dependencies first followed by the soft ones
+		TArray<FName> Dependencies;
+
+		int32 NumHardDependencies = 0;
+
+		bool bFetched = false;
+	};
+
+	// Every package known to the snapshot, either with stored dependencies or only as a dependency
+	TArray<FName> PackageNames;
+
+	TMap<FName, int32> PackageIndices;
+
+	// Views into the mapped file, one guid, hard dependency count and offset per package
+	const FGuid* PackageGuids = nullptr;
+
+	const uint32* NumHardDependencies = nullptr;
+
+	// NumPackages + 1 entries, the dependencies of a package are Edges[Offsets[Index]] to Edges[Offsets[Index + 1]]
+	const uint32* Offsets = nullptr;
+
+	const uint32* Edges = nullptr;
+
+	// Snapshot packages changed since the snapshot was taken
+	TBitArray<> StalePackages;
+
+	TMap<FName, FOverlayEntry> Overlay;
+
+	IMappedFileHandle* MappedFile = nullptr;
+
+	IMappedFileRegion* MappedRegion = nullptr;
+
+	// Used instead of the mapping if the platform can't map files
+	TArray<uint8> FileData;
+
+	bool bDirty = false;
+
+	FOWIPackageChangeListener PackageChangeListener;
+
+	static FString GetGraphFilePath();
+
+	/**
+	 * \brief Point the views at the loaded file, checking all sizes and indices
+	 * \param Data The file content
+	 * \param Size The size of the file content
+	 * \return True if the file is a valid snapshot
+	 */
+	bool ReadSnapshot(const uint8* Data, int64 Size);
+
+	/**
+	 * \brief Release the mapped file and forget the snapshot
+	 */
+	void Unmap();
+
+	/**
+	 * \brief Find the package in the snapshot if its stored dependencies are still valid
+	 * \param PackageName The package to look up
+	 * \param AssetRegistry The Asset Registry to get the guid of the saved package from
+	 * \return The index of the package or INDEX_NONE
+	 */
+	int32 FindValidSnapshotPackage(FName PackageName, const IAssetRegistry& AssetRegistry) const;
+
+	/**
+	 * \brief Get the dependencies of a package from the overlay, fetching them from the Asset Registry if needed
+	 * \param PackageName The package to get the dependencies for
+	 * \param AssetRegistry The Asset Registry to use
+	 * \return The overlay entry of the package
+	 */
+	const FOverlayEntry& FindOrAddOverlayEntry(FName PackageName, const IAssetRegistry& AssetRegistry);
+};
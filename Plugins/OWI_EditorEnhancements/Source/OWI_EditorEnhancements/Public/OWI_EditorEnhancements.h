@@ -1,24 +1,62 @@
-// Copyright Offworld Industries
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Framework/MultiBox/MultiBoxExtender.h"
-#include "Modules/ModuleManager.h"
-
-class FOWIContentBrowserMenuExtension;
-
-class OWI_EDITORENHANCEMENTS_API FOWIEditorEnhancementsModule final : public IModuleInterface
-{
-public:
-
-	/** IModuleInterface implementation */
-	virtual void StartupModule() override;
-	virtual void ShutdownModule() override;
-
-private:
-	
-	TSharedRef<FExtender> ContentBrowserExtender(const TArray<FString>&Path);
-	
-	TSharedPtr<FOWIContentBrowserMenuExtension> Extension;
-};
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/MultiBox/MultiBoxExtender.h"
+#include "Modules/ModuleManager.h"
+#include "OWI_DependencyGraph.h"
+#include "UObject/Object.h"
+
+class FOWIContentBrowserMenuExtension;
+
+class OWI_EDITORENHANCEMENTS_API FOWIEditorEnhancementsModule final : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/**
+	 * \brief Get the dependency graph shared by all reference rule checks
+	 * \return The dependency graph
+	 */
+	static FOWIDependencyGraph& GetDependencyGraph();
+
+private:
+	
+	TSharedRef<FExtender> ContentBrowserExtender(const TArray<FString>&Path);
+
+	void OnPostEngineInit();
+
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+	void OnHotReload(bool bWasTriggeredAutomatically);
+
+	void OnPostGarbageCollect();
+
+	void OnObjectSaved(UObject* Object);
+
+	void OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags);
+
+	// Classes cached by the naming conventions are not valid anymore
+	static void InvalidateClassCaches();
+	
+	TSharedPtr<FOWIContentBrowserMenuExtension> Extension;
+
+	// Mapped when the module starts so the first validation doesn't have to walk the Asset Registry
+	FOWIDependencyGraph DependencyGraph;
+
+	FDelegateHandle PostEngineInitHandle;
+
+	FDelegateHandle ObjectsReplacedHandle;
+
+	FDelegateHandle HotReloadHandle;
+
+	FDelegateHandle PostGarbageCollectHandle;
+
+	FDelegateHandle ObjectSavedHandle;
+
+	FDelegateHandle GetExtraObjectTagsHandle;
+};
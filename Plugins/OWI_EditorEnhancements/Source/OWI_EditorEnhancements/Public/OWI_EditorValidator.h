@@ -1,27 +1,78 @@
-// Copyright Offworld Industries
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "EditorValidatorBase.h"
-#include "OWI_EditorValidator.generated.h"
-
-UCLASS()
-class OWI_EDITORENHANCEMENTS_API UOWIEditorValidator final : public UEditorValidatorBase
-{
-	GENERATED_BODY()
-
-public:
-
-	virtual bool IsEnabled() const override;
-	
-protected:
-	
-	virtual bool CanValidateAsset_Implementation(UObject* InAsset) const override;
-	
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors) override;
-
-private:
-	
-	const FString ErrorPrefix = "LogOwiAssetValidation: ";
-};
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidatorBase.h"
+#include "OWI_ValidationCache.h"
+#include "OWI_EditorValidator.generated.h"
+
+class UOWIReferenceRulesHandler;
+class UOWINamingConventionHandler;
+
+UCLASS()
+class OWI_EDITORENHANCEMENTS_API UOWIEditorValidator final : public UEditorValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void PostInitProperties() override;
+
+	virtual void BeginDestroy() override;
+
+	virtual bool IsEnabled() const override;
+	
+protected:
+	
+	virtual bool CanValidateAsset_Implementation(UObject* InAsset) const override;
+	
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(UObject* InAsset, TArray<FText>& ValidationErrors) override;
+
+private:
+	
+	const FString ErrorPrefix = "LogOwiAssetValidation: ";
+
+	// Handlers are kept for the lifetime of the validator so their caches survive between Assets
+	UPROPERTY(Transient)
+	UOWIReferenceRulesHandler* ReferenceRulesHandler = nullptr;
+
+	UPROPERTY(Transient)
+	UOWINamingConventionHandler* NamingConventionHandler = nullptr;
+
+	// Results of unchanged packages from earlier validations and sessions
+	FOWIValidationCache ValidationCache;
+
+	bool bInValidationBatch = false;
+
+	FDelegateHandle EndValidationBatchHandle;
+
+	/**
+	 * \brief Start a validation batch if none is running, the batch ends with the next tick
+	 */
+	void BeginValidationBatch();
+
+	/**
+	 * \brief End the current validation batch and drop what was cached during it
+	 * \param DeltaTime Unused tick time
+	 * \return False so the ticker is removed again
+	 */
+	bool EndValidationBatch(float DeltaTime);
+
+	/**
+	 * \brief Run a check unless its result for the saved state of the package is cached
+	 * \param InAsset The Asset to check
+	 * \param Check The type of check to run
+	 * \param ValidationError The Error Text if any
+	 * \return True if the check failed
+	 */
+	bool IsViolated(UObject* InAsset, EOWIValidationCheck Check, FString& ValidationError);
+
+	/**
+	 * \brief Report every line of a failed check as its own validation error
+	 * \param InAsset The Asset that failed
+	 * \param ValidationError The Error Text of the check
+	 * \param ValidationErrors The validation errors to add to
+	 */
+	void AddValidationErrors(UObject* InAsset, const FString& ValidationError, TArray<FText>& ValidationErrors);
+};
@@ -0,0 +1,112 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_PathTrie.h"
+
+enum EPathState
+{
+	None,
+    Released,
+    Unreleased,
+    Mixed
+};
+
+/**
+ * The release state of content folders, stored per node of a FOWIPathTrie ("/Game/Foo/Bar" -> "Game", "Foo", "Bar").
+ * Every node knows how many folders within it are tracked in each state, so finding the tracked parents of a folder
+ * or whether anything within a folder is unreleased only takes as long as the path is deep.
+ * Built from the config arrays of UOWIUnReleasedAssetsHandlerSettings and only written back to them when saving.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIFolderStateTree
+{
+
+public:
+
+	FOWIFolderStateTree();
+
+	/**
+	 * \brief Remove all folders
+	 */
+	void Reset();
+
+	/**
+	 * \brief Replace the tree with the folders of the config arrays
+	 * \param UnreleasedFolders The folders marked as unreleased
+	 * \param ReleasedFolders The folders marked as released
+	 * \param MixedFolders The released folders containing unreleased folders
+	 */
+	void Build(const TArray<FString>& UnreleasedFolders, const TArray<FString>& ReleasedFolders, const TArray<FString>& MixedFolders);
+
+	/**
+	 * \brief Write the tracked folders back into the config arrays, sorted by path
+	 * \param OutUnreleasedFolders The folders marked as unreleased
+	 * \param OutReleasedFolders The folders marked as released
+	 * \param OutMixedFolders The released folders containing unreleased folders
+	 */
+	void Export(TArray<FString>& OutUnreleasedFolders, TArray<FString>& OutReleasedFolders, TArray<FString>& OutMixedFolders) const;
+
+	/**
+	 * \brief Track a folder in the given state
+	 * \param FolderPath The folder, e.g. "/Game/Developers"
+	 * \param State The new state of the folder, None stops tracking it
+	 */
+	void SetState(const FString& FolderPath, EPathState State);
+
+	/**
+	 * \brief Get the state the folder itself is tracked in
+	 * \param FolderPath The folder to look up
+	 * \return The state of the folder or None if it isn't tracked
+	 */
+	EPathState GetState(const FString& FolderPath) const;
+
+	/**
+	 * \brief Is the folder marked as unreleased or within a folder that is?
+	 * \param FolderPath The folder to check
+	 * \return True if the folder is unreleased
+	 */
+	bool IsUnreleased(const FString& FolderPath) const;
+
+	/**
+	 * \brief Get the folders containing the given one that are tracked in the given state
+	 * \param FolderPath The folder to start at, it isn't part of the result itself
+	 * \param State The state to look for
+	 * \param OutAncestors The tracked folders, the nearest one first
+	 */
+	void GetTrackedAncestors(const FString& FolderPath, EPathState State, TArray<FString>& OutAncestors) const;
+
+	/**
+	 * \brief Is any folder within the given one tracked in the given state?
+	 * \param FolderPath The folder to check, it isn't counted itself
+	 * \param State The state to look for
+	 * \return True if there is at least one such folder
+	 */
+	bool HasTrackedDescendants(const FString& FolderPath, EPathState State) const;
+
+	/**
+	 * \brief How many folders are tracked?
+	 * \return The number of folders with a state other than None
+	 */
+	int32 Num() const;
+
+private:
+
+	struct FFolder
+	{
+		EPathState State = None;
+
+		// The path as it was given, so it is written back unchanged
+		FString Path;
+
+		// The number of tracked folders within this one per state, indexed by EPathState
+		int32 NumDescendants[4] = { 0, 0, 0, 0 };
+	};
+
+	FOWIPathTrie Paths;
+
+	// Indexed by the nodes of Paths, node 0 is the root
+	TArray<FFolder> Folders;
+
+	int32 NumTracked = 0;
+};
@@ -0,0 +1,101 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The blacklist array of the ModSDK create_file_list.sh script as a set of folders.
+ * The array is parsed once, changed in memory and written back in one go through a temporary file, so the script is
+ * never left half written. The entries are written sorted, one folder per line with the quoting it had in the script;
+ * comments within the array are kept in front of them. Folders are compared case sensitive, just like bash does.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIModSDKBlacklist
+{
+
+public:
+
+	/**
+	 * \brief Read the script and parse its blacklist array
+	 * \param InFilePath The script to read
+	 * \param BlacklistStart The text the array starts with, e.g. "declare -a blacklist=("
+	 * \return False if the script could not be read or doesn't contain the array
+	 */
+	bool Load(const FString& InFilePath, const FString& BlacklistStart);
+
+	/**
+	 * \brief Parse the blacklist array from the script content
+	 * \param Content The content of the script
+	 * \param BlacklistStart The text the array starts with
+	 * \return False if the content doesn't contain the array
+	 */
+	bool Parse(const FString& Content, const FString& BlacklistStart);
+
+	/**
+	 * \brief Write the script with the changed array, does nothing if the entries are the same as in the script
+	 * \return False if the script could not be written
+	 */
+	bool Save();
+
+	/**
+	 * \brief Get the script content with the current entries
+	 * \return The content to write
+	 */
+	FString ToString() const;
+
+	void Add(const FString& Folder);
+
+	void Remove(const FString& Folder);
+
+	bool Contains(const FString& Folder) const;
+
+	/**
+	 * \brief Do the entries differ from the ones in the script?
+	 * \return True if the script needs to be written
+	 */
+	bool IsChanged() const;
+
+	int32 Num() const;
+
+private:
+
+	/** Folders differing only in case are different folders to bash */
+	struct FCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, FString, false>
+	{
+		static bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+
+		static uint32 GetKeyHash(const FString& Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
+	// The folder mapped to the word as it is written in the script, quotes included
+	using FEntryMap = TMap<FString, FString, FDefaultSetAllocator, FCaseSensitiveKeyFuncs>;
+
+	/**
+	 * \brief Quote a new folder, single quotes if double quotes would expand anything in it
+	 * \param Folder The folder to quote
+	 * \return The word to write into the script
+	 */
+	static FString QuoteEntry(const FString& Folder);
+
+	FString FilePath;
+
+	// Everything up to and including the start of the array
+	FString Prefix;
+
+	// The closing parenthesis of the array and everything after it
+	FString Suffix;
+
+	// Comments within the array, kept as they are
+	TArray<FString> Comments;
+
+	FEntryMap Entries;
+
+	// The entries as they are in the script, to only write it if anything actually changed
+	FEntryMap SavedEntries;
+};
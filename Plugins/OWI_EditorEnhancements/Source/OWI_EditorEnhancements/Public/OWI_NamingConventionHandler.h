@@ -1,163 +1,337 @@
-﻿#pragma once
-
-// Copyright Offworld Industries
-
-#include "CoreMinimal.h"
-#include "Engine/DeveloperSettings.h"
-#include "OWI_NamingConventionHandler.generated.h"
-
-struct FDirectoryPath;
-enum EBlueprintType;
-class UMaterial;
-class UMaterialInstance;
-class USkeletalMesh;
-
-USTRUCT()
-struct OWI_EDITORENHANCEMENTS_API FOWIPrefixSuffix
-{
-    GENERATED_USTRUCT_BODY()
-
-public:
-	
-    UPROPERTY(Config, Noclear, EditAnywhere, Category = "OWI Naming Conventions")
-    FString Prefix;  
-      
-    UPROPERTY(Config, Noclear, EditAnywhere, Category = "OWI Naming Conventions", Meta = (DisplayName = "Optional Suffix"))
-    FString OptionalSuffix;
-	
-};
-
-/**
-* Class to configure the UOWINamingConventionHandler
-*/
-UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Naming Conventions"))
-class OWI_EDITORENHANCEMENTS_API UOWINamingConventionHandlerSettings final : public UDeveloperSettings
-{
-	GENERATED_BODY()
-
-public:
-	
-    UPROPERTY(EditAnywhere, Config, Category = "OWI Naming Conventions")
-    bool bEnabled = true;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	TMap<FString, FOWIPrefixSuffix> GenericPrefixMap;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	TMap<UObject*, FOWIPrefixSuffix> UObjectPrefixMap;
-
-    UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-    TMap<UClass*, FOWIPrefixSuffix> UClassPrefixMap;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	TMap<TEnumAsByte<enum EBlueprintType>, FOWIPrefixSuffix> EBlueprintTypePrefixMap;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix Material_WithPostProcessing;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix Material_WithoutPostProcessing;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix MaterialInstance_WithPostProcessing;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix MaterialInstance_WithoutPostProcessing;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix SkeletalMesh_WithMorphTargets;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
-	FOWIPrefixSuffix SkeletalMesh_WithoutMorphTargets;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled", ContentDir))
-	TArray<FDirectoryPath> FolderWhitelist;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled", ContentDir))
-	TArray<FDirectoryPath> FolderBlacklist;
-	
-};
-
-UCLASS()
-class OWI_EDITORENHANCEMENTS_API UOWINamingConventionHandler final : public UObject
-{
-    GENERATED_BODY()
-
-public:
-    
-    /**
-     * \brief Can any naming convention be applied to this Asset?
-     * \param Asset The Asset to check
-     * \return True if a naming convention can be applied
-     */
-    bool NamingConventionCanBeApplied(UObject* Asset);
-
-    /**
-     * \brief Is any naming convention violated?
-     * \param Asset The Asset to check
-	 * \param ValidationError The Error Text if any
-     * \return True if a naming convention is violated
-     */
-    bool NamingConventionIsViolated(UObject* Asset, FString& ValidationError);
-
-    /**
-     * @brief Rename the Asset to match Naming Conventions
-     * @param Asset The Asset to rename
-     */
-	void RenameAsset(UObject* Asset);
-
-private:
-
-	// Pointer holding the current settings
-	UPROPERTY()
-	UOWINamingConventionHandlerSettings* Settings = nullptr;
-	
-	/**
-	 * @brief Get the closest PrefixSuffix by using the Parent Object
-	 * @param Object The object to search for
-	 * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* GetUObjectPrefixSuffix(UObject* Object);
-
-    /**
-     * @brief Get the closets PrefixSuffix by using the Parent Class
-     * @param ObjectClass The class of the object to search for
-     * \return The closest PrefixSuffix or nullptr if none found
-     */
-	FOWIPrefixSuffix* GetUClassPrefixSuffix(const UClass* ObjectClass);
-
-	/**
-	 * @brief Get the closest PrefixSuffix by using the Class Name
-	 * @param ClassName The FString to search for
-     * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* GetGenericPrefixSuffix(const FString& ClassName);
-
-	/**
-	 * @brief Get the PrefixSuffix if it is a Blueprint
-	 * @param Blueprint The Blueprint to check
-	 * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* CheckBlueprintTypes(const UBlueprint* Blueprint);
-
-	/**
-	 * @brief Get the PrefixSuffix if it is a Material
-	 * @param Material The Material to search check
-	 * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* CheckMaterialTypes(const UMaterial* Material);
-
-	/**
-	 * @brief Get the PrefixSuffix if it is a Material Interface
-	 * @param MaterialInstance The Material to search check
-	 * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* CheckMaterialInstanceTypes(UMaterialInstance* MaterialInstance);
-
-	/**
-	 * @brief Get the PrefixSuffix if it is a Skeletal Mesh
-	 * @param SkeletalMeshInstance The Skeletal Mesh to search check
-	 * \return The closest PrefixSuffix or nullptr if none found
-	 */
-	FOWIPrefixSuffix* CheckSkeletalMeshTypes(USkeletalMesh* SkeletalMeshInstance);
-};
+﻿#pragma once
+
+// Copyright Offworld Industries
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "OWI_PathTrie.h"
+#include "OWI_NamingConventionHandler.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOWINamingConventions, Log, All);
+
+struct FAssetData;
+struct FDirectoryPath;
+enum EBlueprintType;
+class UMaterial;
+class UMaterialInstance;
+class UMaterialInterface;
+class USkeletalMesh;
+
+USTRUCT()
+struct OWI_EDITORENHANCEMENTS_API FOWIPrefixSuffix
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+	
+    UPROPERTY(Config, Noclear, EditAnywhere, Category = "OWI Naming Conventions")
+    FString Prefix;  
+      
+    UPROPERTY(Config, Noclear, EditAnywhere, Category = "OWI Naming Conventions", Meta = (DisplayName = "Optional Suffix"))
+    FString OptionalSuffix;
+	
+};
+
+/**
+* Class to configure the UOWINamingConventionHandler
+*/
+UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Naming Conventions"))
+class OWI_EDITORENHANCEMENTS_API UOWINamingConventionHandlerSettings final : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	
+    UPROPERTY(EditAnywhere, Config, Category = "OWI Naming Conventions")
+    bool bEnabled = true;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	TMap<FString, FOWIPrefixSuffix> GenericPrefixMap;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	TMap<UObject*, FOWIPrefixSuffix> UObjectPrefixMap;
+
+    UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+    TMap<UClass*, FOWIPrefixSuffix> UClassPrefixMap;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	TMap<TEnumAsByte<enum EBlueprintType>, FOWIPrefixSuffix> EBlueprintTypePrefixMap;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix Material_WithPostProcessing;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix Material_WithoutPostProcessing;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix MaterialInstance_WithPostProcessing;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix MaterialInstance_WithoutPostProcessing;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix SkeletalMesh_WithMorphTargets;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled"))
+	FOWIPrefixSuffix SkeletalMesh_WithoutMorphTargets;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled", ContentDir))
+	TArray<FDirectoryPath> FolderWhitelist;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Naming Conventions", Meta = (EditCondition = "bEnabled", ContentDir))
+	TArray<FDirectoryPath> FolderBlacklist;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+
+	/**
+	 * @brief Get the PrefixSuffix a class was already resolved to
+	 * @param ObjectClass The class to look up
+	 * @param OutPrefixSuffix The resolved PrefixSuffix, may be nullptr if none matched
+	 * \return True if the class was resolved before
+	 */
+	bool FindResolvedClass(const UClass* ObjectClass, FOWIPrefixSuffix*& OutPrefixSuffix) const;
+
+	/**
+	 * @brief Remember what a class was resolved to
+	 * @param ObjectClass The resolved class
+	 * @param PrefixSuffix The resolved PrefixSuffix or nullptr if none matched
+	 */
+	void AddResolvedClass(const UClass* ObjectClass, FOWIPrefixSuffix* PrefixSuffix);
+
+	/**
+	 * @brief Forget everything resolved so far, e.g. because the settings or classes changed
+	 */
+	void InvalidateCaches();
+
+	/**
+	 * @brief Forget only the classes that were garbage collected, everything else is still resolved correctly
+	 */
+	void RemoveStaleClasses();
+
+	/**
+	 * @brief Get the post processing classification a material was already resolved to
+	 * @param MaterialPath The path of the material to look up
+	 * @param bOutPostProcess Whether the base material of the material is a post process material
+	 * \return True if the material was resolved before
+	 */
+	bool FindResolvedMaterial(FName MaterialPath, bool& bOutPostProcess) const;
+
+	/**
+	 * @brief Remember the post processing classification of a material
+	 * @param MaterialPath The path of the resolved material
+	 * @param ParentPath The path of the parent it was resolved through, None for a base material
+	 * @param bPostProcess Whether the base material of the material is a post process material
+	 */
+	void AddResolvedMaterial(FName MaterialPath, FName ParentPath, bool bPostProcess);
+
+	/**
+	 * @brief Forget the classification of a material and of every material resolved through it, e.g. because it was saved
+	 * @param MaterialPath The path of the changed material
+	 */
+	void InvalidateResolvedMaterial(FName MaterialPath);
+
+	/**
+	 * @brief Is the Asset inside a whitelisted folder and not inside a blacklisted one?
+	 * @param AssetPath The path of the Asset
+	 * \return True if the naming conventions should be checked for this Asset
+	 */
+	bool IsInCheckedFolder(const FString& AssetPath) const;
+
+	/**
+	 * @brief Get the GenericPrefixMap entry matching the display name of the class
+	 * @param ObjectClass The class to look up
+	 * \return The PrefixSuffix or nullptr if there is no entry for the class
+	 */
+	FOWIPrefixSuffix* FindGenericPrefixSuffix(const UClass* ObjectClass);
+
+	/**
+	 * @brief Get the GenericPrefixMap entry with the given name
+	 * @param ClassName The name to look up
+	 * \return The PrefixSuffix or nullptr if there is no such entry
+	 */
+	FOWIPrefixSuffix* FindGenericPrefixSuffix(FName ClassName);
+
+private:
+
+	// Class to PrefixSuffix resolved by walking the class hierarchy, weak so a new class at the address of a collected one
+	// is never mistaken for it
+	TMap<TWeakObjectPtr<const UClass>, FOWIPrefixSuffix*> ResolvedClasses;
+
+	// Material path to whether its base material is a post process material, paths survive garbage collection
+	TMap<FName, bool> ResolvedMaterials;
+
+	// Parent material path to the paths of the resolved materials directly using it
+	TMultiMap<FName, FName> ResolvedMaterialChildren;
+
+	// FolderWhitelist and FolderBlacklist tagged into one trie, built on first use
+	mutable FOWIPathTrie FolderFilter;
+
+	mutable bool bFolderFilterCompiled = false;
+
+	// GenericPrefixMap keyed by FName, so lookups don't need to hash strings
+	TMap<FName, FOWIPrefixSuffix*> GenericNames;
+
+	// Every class resolved against the GenericPrefixMap by its display name, weak so garbage collection doesn't invalidate it
+	TMap<TWeakObjectPtr<const UClass>, FOWIPrefixSuffix*> GenericClasses;
+
+	bool bGenericPrefixMapCompiled = false;
+
+	/**
+	 * @brief Resolve the GenericPrefixMap against all loaded classes and warn about entries without a class
+	 */
+	void CompileGenericPrefixMap();
+
+	/**
+	 * @brief Forget everything built from the settings themselves
+	 */
+	void InvalidateCompiledSettings();
+	
+};
+
+UCLASS()
+class OWI_EDITORENHANCEMENTS_API UOWINamingConventionHandler final : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    
+    /**
+     * \brief Can any naming convention be applied to this Asset?
+     * \param Asset The Asset to check
+     * \return True if a naming convention can be applied
+     */
+    bool NamingConventionCanBeApplied(UObject* Asset);
+
+    /**
+     * \brief Is any naming convention violated?
+     * \param Asset The Asset to check
+	 * \param ValidationError The Error Text if any
+     * \return True if a naming convention is violated
+     */
+    bool NamingConventionIsViolated(UObject* Asset, FString& ValidationError);
+
+    /**
+     * \brief Is any naming convention violated? Decided from the Asset Registry data where possible,
+     * only Materials, Material Instances, Skeletal Meshes and Assets of unknown classes are loaded.
+     * \param AssetData The Asset to check
+	 * \param ValidationError The Error Text if any
+     * \return True if a naming convention is violated
+     */
+    bool NamingConventionIsViolated(const FAssetData& AssetData, FString& ValidationError);
+
+    /**
+     * @brief Rename the Asset to match Naming Conventions
+     * @param Asset The Asset to rename
+     */
+	void RenameAsset(UObject* Asset);
+
+	/**
+	 * @brief Rename all Assets to match Naming Conventions as one batch.
+	 * All new names are computed first, Assets whose new name collides with an existing Asset or another
+	 * Asset of the batch are skipped. Referencers are fixed up once for the whole batch afterwards.
+	 * @param Assets The Assets to rename
+	 * \return The number of renamed Assets
+	 */
+	int32 RenameAssets(const TArray<UObject*>& Assets);
+
+	/**
+	 * @brief Get the name the Asset should have according to the Naming Conventions
+	 * @param Asset The Asset to get the name for
+	 * @param OutNewName The name matching the Naming Conventions
+	 * \return True if the Asset needs to be renamed
+	 */
+	bool GetConventionalName(UObject* Asset, FString& OutNewName);
+
+	/**
+	 * @brief Is the base material of the material a post process material? Memoized per material path.
+	 * @param Material The material to check
+	 * \return True if the base material is a post process material
+	 */
+	static bool IsPostProcessMaterial(const UMaterialInterface* Material);
+
+	// Asset Registry tag holding the result of IsPostProcessMaterial as of the last save
+	static const FName PostProcessMaterialTag;
+
+private:
+
+	// Pointer holding the current settings
+	UPROPERTY()
+	UOWINamingConventionHandlerSettings* Settings = nullptr;
+	
+	/**
+	 * @brief Get the closest PrefixSuffix by using the Parent Object
+	 * @param Object The object to search for
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* GetUObjectPrefixSuffix(UObject* Object);
+
+	/**
+	 * @brief Get the closest PrefixSuffix from the Asset Registry data, same order as GetUObjectPrefixSuffix
+	 * @param AssetData The Asset to search for
+	 * @param bOutNeedsLoading Set if the decision depends on the loaded object
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* GetAssetDataPrefixSuffix(const FAssetData& AssetData, bool& bOutNeedsLoading);
+
+	/**
+	 * @brief Get the PrefixSuffix of a Blueprint from its Asset Registry tags
+	 * @param AssetData The Blueprint to check
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* CheckBlueprintTypes(const FAssetData& AssetData);
+
+	/**
+	 * @brief Does the name match the PrefixSuffix?
+	 * @param Name The name to check
+	 * @param PrefixSuffix The PrefixSuffix the name has to match
+	 * @param ValidationError The Error Text if any
+	 * \return True if the name doesn't match
+	 */
+	static bool IsNameViolated(const FString& Name, const FOWIPrefixSuffix& PrefixSuffix, FString& ValidationError);
+
+    /**
+     * @brief Get the closets PrefixSuffix by using the Parent Class
+     * @param ObjectClass The class of the object to search for
+     * \return The closest PrefixSuffix or nullptr if none found
+     */
+	FOWIPrefixSuffix* GetUClassPrefixSuffix(const UClass* ObjectClass);
+
+	/**
+	 * @brief Get the closest PrefixSuffix by using the Class Name
+	 * @param ClassName The name to search for
+     * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* GetGenericPrefixSuffix(FName ClassName);
+
+	/**
+	 * @brief Get the PrefixSuffix if it is a Blueprint
+	 * @param Blueprint The Blueprint to check
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* CheckBlueprintTypes(const UBlueprint* Blueprint);
+
+	/**
+	 * @brief Get the PrefixSuffix if it is a Material
+	 * @param Material The Material to search check
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* CheckMaterialTypes(const UMaterial* Material);
+
+	/**
+	 * @brief Get the PrefixSuffix if it is a Material Interface
+	 * @param MaterialInstance The Material to search check
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* CheckMaterialInstanceTypes(UMaterialInstance* MaterialInstance);
+
+	/**
+	 * @brief Get the PrefixSuffix if it is a Skeletal Mesh
+	 * @param SkeletalMeshInstance The Skeletal Mesh to search check
+	 * \return The closest PrefixSuffix or nullptr if none found
+	 */
+	FOWIPrefixSuffix* CheckSkeletalMeshTypes(USkeletalMesh* SkeletalMeshInstance);
+};
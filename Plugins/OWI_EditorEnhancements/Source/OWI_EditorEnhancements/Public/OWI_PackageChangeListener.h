@@ -0,0 +1,64 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+struct FAssetData;
+
+/**
+ * Reports packages the Asset Registry saw change, shared by the caches that store data per saved package.
+ * Changes are ignored while the initial scan runs, it reports every Asset and outdated packages are already rejected
+ * by their package guid.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIPackageChangeListener
+{
+
+public:
+
+	// Called with the name of every changed package, twice for a rename: the old and the new name
+	typedef TFunction<void(FName PackageName)> FOnPackageChanged;
+
+	~FOWIPackageChangeListener();
+
+	/**
+	 * \brief Start listening to the Asset Registry
+	 * \param InOnPackageChanged Called for every changed package
+	 * \param bIncludeAdded Report added Assets as well, not only removed, renamed and updated ones
+	 */
+	void Start(FOnPackageChanged InOnPackageChanged, bool bIncludeAdded);
+
+	/**
+	 * \brief Stop listening, safe to call if the Asset Registry is already gone
+	 */
+	void Stop();
+
+	/**
+	 * \brief Get the guid of the saved package from the Asset Registry
+	 * \param PackageName The package to look up
+	 * \param AssetRegistry The Asset Registry to ask
+	 * \return The package guid or an invalid guid if the package is unknown
+	 */
+	static FGuid GetPackageGuid(FName PackageName, const IAssetRegistry& AssetRegistry);
+
+	static FGuid GetPackageGuid(FName PackageName);
+
+private:
+
+	FOnPackageChanged OnPackageChanged;
+
+	FDelegateHandle AssetAddedHandle;
+
+	FDelegateHandle AssetRemovedHandle;
+
+	FDelegateHandle AssetRenamedHandle;
+
+	FDelegateHandle AssetUpdatedHandle;
+
+	static bool IsInitialScanRunning();
+
+	void OnAssetChanged(const FAssetData& AssetData);
+
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+};
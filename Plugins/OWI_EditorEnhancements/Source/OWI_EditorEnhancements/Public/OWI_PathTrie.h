@@ -0,0 +1,197 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trie over the segments of a content path ("/Game/Foo/Bar.Bar" -> "Game", "Foo", "Bar") keyed by FName.
+ * Every node can carry any number of integer tags, walking a path reports the tags of all nodes that are a
+ * prefix of it. Walking never allocates: segments are only looked up in the name table, never added.
+ * Nodes are indices that stay valid until Reset, so other data can be stored per node next to the trie.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIPathTrie
+{
+
+public:
+
+	FOWIPathTrie();
+
+	/**
+	 * \brief Remove all paths and tags
+	 */
+	void Reset();
+
+	/**
+	 * \brief Add a tag to the node of the given path, creating the node if needed
+	 * \param Path The folder path, e.g. "/Game/Developers"
+	 * \param Tag The tag to report for every path within this folder
+	 */
+	void Insert(const FString& Path, int32 Tag);
+
+	/**
+	 * \brief Get the node of the given path, creating it and its parents if needed
+	 * \param Path The folder path, e.g. "/Game/Developers"
+	 * \return The node of the path, 0 for the root
+	 */
+	int32 FindOrAddNode(const FString& Path);
+
+	/**
+	 * \brief Get the node of the given path without creating it
+	 * \param Path The folder path
+	 * \return The node of the path or INDEX_NONE if there is none
+	 */
+	int32 FindNode(const FString& Path) const;
+
+	/**
+	 * \brief Get the node containing the given one
+	 * \param NodeIndex The node
+	 * \return The parent node or INDEX_NONE for the root
+	 */
+	int32 GetParent(const int32 NodeIndex) const
+	{
+		return Nodes[NodeIndex].Parent;
+	}
+
+	/**
+	 * \brief How many nodes are there, including the root?
+	 * \return The number of nodes, every node index is below it
+	 */
+	int32 NumNodes() const;
+
+	/**
+	 * \brief Has no tag been added yet?
+	 * \return True if walking any path would not report anything
+	 */
+	bool IsEmpty() const;
+
+	/**
+	 * \brief Call the Visitor for every tag on the way from the root to the deepest node matching the Path
+	 * \param Path The path to walk, either a package name or an object path
+	 * \param Visitor Callable taking the tag as int32
+	 */
+	template <typename VisitorType>
+	void ForEachPrefixTag(const FName Path, VisitorType&& Visitor) const
+	{
+		const FNameBuilder PathBuilder(Path);
+		ForEachPrefixTag(PathBuilder.ToString(), PathBuilder.Len(), Forward<VisitorType>(Visitor));
+	}
+
+	template <typename VisitorType>
+	void ForEachPrefixTag(const FString& Path, VisitorType&& Visitor) const
+	{
+		ForEachPrefixTag(*Path, Path.Len(), Forward<VisitorType>(Visitor));
+	}
+
+	template <typename VisitorType>
+	void ForEachPrefixTag(const TCHAR* Path, const int32 Len, VisitorType&& Visitor) const
+	{
+		for (const int32 Tag : Nodes[0].Tags)
+		{
+			Visitor(Tag);
+		}
+
+		ForEachNodeOnPath(Path, Len, [this, &Visitor](const int32 NodeIndex)
+		{
+			for (const int32 Tag : Nodes[NodeIndex].Tags)
+			{
+				Visitor(Tag);
+			}
+		});
+	}
+
+	/**
+	 * \brief Call the Visitor for every node below the root on the way to the deepest node matching the Path
+	 * \param Path The path to walk
+	 * \param Len The length of the path
+	 * \param Visitor Callable taking the node index as int32
+	 * \return True if there is a node for every segment of the path
+	 */
+	template <typename VisitorType>
+	bool ForEachNodeOnPath(const TCHAR* Path, const int32 Len, VisitorType&& Visitor) const
+	{
+		int32 NodeIndex = 0;
+		bool bFound = true;
+		ForEachSegment(Path, Len, [this, &NodeIndex, &bFound, &Visitor](const TCHAR* Segment, const int32 SegmentLen)
+		{
+			// A segment that isn't even in the name table can't be part of any configured path
+			const FName SegmentName(SegmentLen, Segment, FNAME_Find);
+			const int32* ChildIndex = SegmentName.IsNone() ? nullptr : Nodes[NodeIndex].Children.Find(SegmentName);
+			if (ChildIndex == nullptr)
+			{
+				bFound = false;
+				return false;
+			}
+
+			NodeIndex = *ChildIndex;
+			Visitor(NodeIndex);
+			return true;
+		});
+
+		return bFound;
+	}
+
+	/**
+	 * \brief Is the Path inside the Folder? Same segment semantics as the trie, but without building one
+	 * \param Path The path to check
+	 * \param Len The length of the path
+	 * \param Folder The folder to check against
+	 * \return True if the Path is the Folder itself or anything within
+	 */
+	static bool IsInFolder(const TCHAR* Path, int32 Len, const FString& Folder);
+
+	static bool IsInFolder(const FName Path, const FString& Folder)
+	{
+		const FNameBuilder PathBuilder(Path);
+		return IsInFolder(PathBuilder.ToString(), PathBuilder.Len(), Folder);
+	}
+
+	static bool IsInFolder(const FString& Path, const FString& Folder)
+	{
+		return IsInFolder(*Path, Path.Len(), Folder);
+	}
+
+	/**
+	 * \brief Split a path into its folder segments, stopping at the object name part ('.' or ':')
+	 * \param Path The path to split
+	 * \param Len The length of the path
+	 * \param Callback Called with each segment, return false to stop
+	 */
+	template <typename CallbackType>
+	static void ForEachSegment(const TCHAR* Path, const int32 Len, CallbackType&& Callback)
+	{
+		int32 Start = 0;
+		while (Start < Len)
+		{
+			if (Path[Start] == TEXT('/'))
+			{
+				++Start;
+				continue;
+			}
+
+			int32 End = Start;
+			while (End < Len && Path[End] != TEXT('/') && Path[End] != TEXT('.') && Path[End] != TEXT(':'))
+			{
+				++End;
+			}
+
+			if (Callback(Path + Start, End - Start) == false || End >= Len || Path[End] != TEXT('/'))
+			{
+				return;
+			}
+			Start = End + 1;
+		}
+	}
+
+private:
+
+	struct FNode
+	{
+		TMap<FName, int32> Children;
+		TArray<int32> Tags;
+		int32 Parent = INDEX_NONE;
+	};
+
+	// Node 0 is the root, every other node is reachable through the Children of its parent
+	TArray<FNode> Nodes;
+};
@@ -0,0 +1,94 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_StronglyConnectedComponents.h"
+
+/**
+ * Answers which forbidden folders a package reaches through any chain of dependencies.
+ * Every package is classified into a set of bits (e.g. one per rule whose forbidden folder contains it). The graph is
+ * condensed into its strongly connected components and each component stores the bits of everything reachable from
+ * it, computed once while the components are found. A query is then a lookup and a few word ORs, however long the
+ * dependency chains are. Like FOWICircularDependencyDetector the graph is explored lazily until Reset is called.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIReachabilityIndex
+{
+
+public:
+
+	// Fills the dependencies of the given package that should be part of the graph
+	typedef FOWIStronglyConnectedComponents::FGetDependencies FGetDependencies;
+
+	// Sets the bits of the given package itself, the array is already sized to the number of bits
+	typedef TFunctionRef<void(FName PackageName, TBitArray<>& OutBits)> FClassifyPackage;
+
+	/**
+	 * \brief Forget the explored graph, e.g. because dependencies or the meaning of the bits changed
+	 * \param InNumBits The number of bits every package is classified into
+	 */
+	void Reset(int32 InNumBits);
+
+	/**
+	 * \brief Add the bits of the package and everything it reaches
+	 * \param PackageName The package to start at
+	 * \param GetDependencies Provides the dependencies of packages not explored yet
+	 * \param ClassifyPackage Provides the bits of packages not explored yet
+	 * \param InOutBits The bits to add to, sized to the number of bits
+	 */
+	void AddReachableBits(FName PackageName, FGetDependencies GetDependencies, FClassifyPackage ClassifyPackage, TBitArray<>& InOutBits);
+
+	/**
+	 * \brief Find the shortest dependency chain to a package that has a bit itself, only within the explored graph
+	 * \param StartPackages The packages to start at, e.g. the dependencies of an Asset
+	 * \param Bit The bit to look for
+	 * \param OutPath The packages along the chain, starting with one of the start packages
+	 * \return True if a chain was found
+	 */
+	bool FindPath(const TArray<FName>& StartPackages, int32 Bit, TArray<FName>& OutPath) const;
+
+	/**
+	 * \brief How many packages have been explored so far?
+	 * \return The number of nodes in the graph
+	 */
+	int32 Num() const;
+
+	/**
+	 * \brief How many bits is every package classified into?
+	 * \return The number of bits given to Reset
+	 */
+	int32 GetNumBits() const;
+
+private:
+
+	FOWIStronglyConnectedComponents Components;
+
+	// The bits of every node itself, WordsPerBitSet words per node
+	TArray<uint32> NodeWords;
+
+	// The bits reachable from every component, WordsPerBitSet words per component
+	TArray<uint32> ComponentWords;
+
+	int32 NumBits = 0;
+
+	int32 WordsPerBitSet = 0;
+
+	static bool HasBit(const uint32* Words, int32 Bit)
+	{
+		return (Words[Bit / 32] & (1u << (Bit % 32))) != 0;
+	}
+
+	/**
+	 * \brief Store the bits of a newly reached node
+	 * \param Node The node
+	 * \param ClassifyPackage Provides the bits of the node
+	 */
+	void ClassifyNode(int32 Node, FClassifyPackage ClassifyPackage);
+
+	/**
+	 * \brief Combine the bits of a finished component with the bits of every component it depends on
+	 * \param Component The component whose members are all known
+	 * \param Members The nodes of the component
+	 */
+	void FinishComponent(int32 Component, const TArray<int32>& Members);
+};
@@ -1,137 +1,384 @@
-// Copyright Offworld Industries
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Engine/EngineTypes.h"
-#include "Engine/DeveloperSettings.h"
-#include "OWI_ReferenceRulesHandler.generated.h"
-
-struct FAssetData;
-class FAssetRegistryModule;
-
-/** Configurable properties for reference rule. */
-USTRUCT()
-struct OWI_EDITORENHANCEMENTS_API FOWIReferenceRule
-{
-	GENERATED_USTRUCT_BODY()
-
-public:
-	
-	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir))
-    FDirectoryPath AssetFolder;
-    
-	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir))
-	FDirectoryPath MayNotReferenceFolder;
-    
-	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir, TitleProperty = "Path"))
-    TArray<FDirectoryPath> ExceptionFolders;
-		
-	/**
-	* \brief Is this rule violated for the given Asset?
-	* \param AssetPath The Asset path to check
-	* \param References The references to check
-	* \param ValidationError The Error Text if any
-	* \return True if the rule is violated, false otherwise
-	*/
-	bool IsViolated(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError) const;
-
-	/**
-	 * \brief Can this rule be applied?
-	 * \param AssetPath The AssetPath to check for
-	 * \return True if this rule can be applied, false otherwise
-	 */
-	bool CanBeApplied(const FString& AssetPath) const;
-	
-private:
-
-	/**
-	 * \brief Is there an exception for the given Reference?
-	 * \param Reference The reference to check against the exceptions
-	 * \return True if the given reference has an exception
-	 */
-	bool IsException(const FName& Reference) const;
-
-};
-
-/**
-* Class to configure the UTRTextureFactory
-*/
-UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Reference Rules"))
-class OWI_EDITORENHANCEMENTS_API UOWIReferenceRulesHandlerSettings final : public UDeveloperSettings
-{
-	GENERATED_BODY()
-
-public:
-	
-	UPROPERTY(EditAnywhere, Config, Category = "OWI Reference Rules")
-	bool bEnabled = true;
-	
-	UPROPERTY(EditAnywhere, Config, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled"))
-	bool bCheckCircularDependencies = false;
-	
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled", TitleProperty = "AssetFolder"))
-	TArray<FOWIReferenceRule> ReferenceRules;
-		
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled", ContentDir))
-	TArray<FDirectoryPath> BlackList;
-};
-
-UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Reference Rules"))
-class OWI_EDITORENHANCEMENTS_API UOWIReferenceRulesHandler final : public UObject
-{
-	GENERATED_BODY()
-
-public:
-
-	/**
-	 * \brief Is any rule violated?
-	 * \param AssetPath The Asset path to check
-	 * \param ValidationError The Error Text if any
-	 * \return True if at least one rule was violated
-	 */
-	bool RuleIsViolated(const FString& AssetPath, FString& ValidationError);
-	
-	/**
-	* \brief Can a rule be applied?
-	* \param AssetPath The Asset path to check
-	* \return True if at least one rule can be applied
-	*/
-	bool RuleCanBeApplied(const FString& AssetPath);
-
-private:
-
-	// All available Settings
-	UPROPERTY()
-	UOWIReferenceRulesHandlerSettings* Settings = nullptr;
-	
-	/**
-	 * \brief Checks all rules
-	 * \param AssetPath The path of the Asset to check
-	 * \param AssetRegistry The Asset Registry to use
-	 * \param AssetData The Asset data to use
-	 * \param bHardDependencyType Should be checked for hard references?
-	 * \param ValidationError Validation error text if any
-	 * \return True if there are violations
-	 */
-	bool CheckAllRules(const FString& AssetPath, const FAssetRegistryModule& AssetRegistry, const FAssetData& AssetData, const bool bHardDependencyType, FString& ValidationError);
-
-	/**
-	 * \brief Is any of the references blacklisted?
-	 * \param AssetPath The path of the Asset to check
-	 * \param References The references to check
-	 * \param ValidationError THe validation error to write to
-	 * \return True if any of the given references is blacklisted
-	 */
-	bool IsBlackListed(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError);
-
-	/**
-	 * \brief Is any of the references a circular reference?
-	 * \param AssetPath The path of the first Asset to check
-	 * \param AssetRegistry The Asset Registry to use
-	 * \param AssetData The Asset data to use
-	 * \param ValidationError Validation error text if any
-	 * \return True if any of the given references is circular
-	 */
-	static bool HasCircularDependency(const FString& AssetPath, const FAssetRegistryModule& AssetRegistry, const FAssetData& AssetData, FString& ValidationError);
-};
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/DeveloperSettings.h"
+#include "OWI_CircularDependencyDetector.h"
+#include "OWI_ReachabilityIndex.h"
+#include "OWI_ReferenceRulesMatcher.h"
+#include "OWI_ReferenceRulesHandler.generated.h"
+
+struct FAssetData;
+class IAssetRegistry;
+
+/** Configurable properties for reference rule. */
+USTRUCT()
+struct OWI_EDITORENHANCEMENTS_API FOWIReferenceRule
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	
+	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir))
+    FDirectoryPath AssetFolder;
+    
+	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir))
+	FDirectoryPath MayNotReferenceFolder;
+    
+	UPROPERTY(Config, NoClear, EditAnywhere, Category = "OWI Reference Rules", Meta = (ContentDir, TitleProperty = "Path"))
+    TArray<FDirectoryPath> ExceptionFolders;
+		
+	/**
+	* \brief Is this rule violated for the given Asset?
+	* \param AssetPath The Asset path to check
+	* \param References The references to check
+	* \param ValidationError The Error Text if any, one line per violating reference
+	* \return True if the rule is violated, false otherwise
+	*/
+	bool IsViolated(const FString& AssetPath, const TArray<FName>& References, FString& ValidationError) const;
+
+	/**
+	 * \brief Can this rule be applied?
+	 * \param AssetPath The AssetPath to check for
+	 * \return True if this rule can be applied, false otherwise
+	 */
+	bool CanBeApplied(const FString& AssetPath) const;
+	
+private:
+
+	/**
+	 * \brief Is there an exception for the given Reference?
+	 * \param Reference The reference to check against the exceptions
+	 * \return True if the given reference has an exception
+	 */
+	bool IsException(const FName& Reference) const;
+
+};
+
+/** The dependencies of a single package as needed by the reference rules */
+struct OWI_EDITORENHANCEMENTS_API FOWIPackageDependencies
+{
+	FName PackageName;
+
+	// All dependencies, the hard ones first followed by the soft ones
+	TArray<FName> Dependencies;
+
+	int32 NumHardDependencies = 0;
+
+	TArrayView<const FName> GetHardDependencies() const
+	{
+		return MakeArrayView(Dependencies.GetData(), NumHardDependencies);
+	}
+};
+
+/**
+* Class to configure the UOWIReferenceRulesHandler
+*/
+UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Reference Rules"))
+class OWI_EDITORENHANCEMENTS_API UOWIReferenceRulesHandlerSettings final : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	
+	UPROPERTY(EditAnywhere, Config, Category = "OWI Reference Rules")
+	bool bEnabled = true;
+	
+	UPROPERTY(EditAnywhere, Config, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled"))
+	bool bCheckCircularDependencies = false;
+
+	// Also report forbidden folders reached through other packages, e.g. an Asset referencing a Material that references a test Texture
+	UPROPERTY(EditAnywhere, Config, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled"))
+	bool bCheckTransitiveReferences = false;
+	
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled", TitleProperty = "AssetFolder"))
+	TArray<FOWIReferenceRule> ReferenceRules;
+		
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI Reference Rules", Meta = (EditCondition = "bEnabled", ContentDir))
+	TArray<FDirectoryPath> BlackList;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+
+	/**
+	 * \brief Get the ReferenceRules and BlackList compiled into a matcher, compiling them if needed
+	 * \return The compiled rules
+	 */
+	const FOWIReferenceRulesMatcher& GetCompiledRules() const;
+
+	/**
+	 * \brief Make sure the rules are compiled again, needs to be called after changing them from code
+	 */
+	void InvalidateCompiledRules();
+
+private:
+
+	// The rules compiled on first use
+	mutable FOWIReferenceRulesMatcher CompiledRules;
+
+	mutable bool bRulesCompiled = false;
+};
+
+/** Which parts of the reference checks to run */
+enum class EOWIReferenceCheckScope : uint8
+{
+	None = 0,
+
+	// The rules and the BlackList against the direct references, only depend on the checked package itself
+	Local = 1 << 0,
+
+	// Circular and transitive dependencies, depend on every package reachable from the checked one
+	Graph = 1 << 1,
+
+	All = Local | Graph
+};
+ENUM_CLASS_FLAGS(EOWIReferenceCheckScope)
+
+/** Which check a reference violation failed */
+enum class EOWIReferenceViolationKind : uint8
+{
+	ReferenceRule,
+	BlackList,
+	CircularDependency,
+	TransitiveReferenceRule,
+	TransitiveBlackList
+};
+
+/** A single violation, only names and indices so collecting it doesn't build any text */
+struct OWI_EDITORENHANCEMENTS_API FOWIReferenceViolation
+{
+	FName PackageName;
+
+	// The reference in the invalid folder, None for circular dependencies
+	FName Reference;
+
+	// The violated rule or BlackList entry
+	int32 Index = INDEX_NONE;
+
+	// The dependency chain of circular and transitive violations in FOWIReferenceViolations::PathPackages
+	int32 FirstPathPackage = INDEX_NONE;
+
+	int32 NumPathPackages = 0;
+
+	EOWIReferenceViolationKind Kind = EOWIReferenceViolationKind::ReferenceRule;
+};
+
+/** All violations found by a check, the text is only built when they are displayed */
+struct OWI_EDITORENHANCEMENTS_API FOWIReferenceViolations
+{
+	TArray<FOWIReferenceViolation> Violations;
+
+	// The dependency chains of all violations one after the other
+	TArray<FName> PathPackages;
+
+	void AddRuleViolation(const FName PackageName, const FName Reference, const int32 RuleIndex);
+
+	void AddBlackListViolation(const FName PackageName, const FName Reference, const int32 EntryIndex);
+
+	void AddCircularDependency(const FName PackageName, const TArray<FName>& CyclePath);
+
+	/**
+	 * \brief Add a forbidden folder reached through other packages
+	 * \param PackageName The checked package
+	 * \param Kind TransitiveReferenceRule or TransitiveBlackList
+	 * \param Index The violated rule or BlackList entry
+	 * \param Path The dependency chain from a dependency of the package to the package in the forbidden folder
+	 */
+	void AddTransitiveViolation(const FName PackageName, const EOWIReferenceViolationKind Kind, const int32 Index, const TArray<FName>& Path);
+
+	/**
+	 * \brief Add the violations of another check, e.g. the one of another package
+	 * \param Other The violations to add
+	 */
+	void Append(const FOWIReferenceViolations& Other);
+
+	void Reset();
+
+	int32 Num() const
+	{
+		return Violations.Num();
+	}
+
+	/**
+	 * \brief Build the text of a single violation
+	 * \param ViolationIndex The violation to describe
+	 * \param Settings The settings the violations were found with, to look up the folders of the rules
+	 * \return The Error Text
+	 */
+	FString ToString(const int32 ViolationIndex, const UOWIReferenceRulesHandlerSettings& Settings) const;
+
+	/**
+	 * \brief Build the text of all violations, one line each
+	 * \param Settings The settings the violations were found with, to look up the folders of the rules
+	 * \return The Error Text
+	 */
+	FString ToString(const UOWIReferenceRulesHandlerSettings& Settings) const;
+};
+
+UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI Reference Rules"))
+class OWI_EDITORENHANCEMENTS_API UOWIReferenceRulesHandler final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * \brief Is any rule violated?
+	 * \param AssetPath The Asset path to check
+	 * \param ValidationError The Error Text if any
+	 * \param Scope Which checks to run
+	 * \return True if at least one rule was violated
+	 */
+	bool RuleIsViolated(const FString& AssetPath, FString& ValidationError, EOWIReferenceCheckScope Scope = EOWIReferenceCheckScope::All);
+
+	/**
+	 * \brief Collect every violated rule
+	 * \param AssetPath The Asset path to check
+	 * \param OutViolations The violations to add to
+	 * \param Scope Which checks to run
+	 * \return True if at least one rule was violated
+	 */
+	bool RuleIsViolated(const FString& AssetPath, FOWIReferenceViolations& OutViolations, EOWIReferenceCheckScope Scope = EOWIReferenceCheckScope::All);
+	
+	/**
+	* \brief Can a rule be applied?
+	* \param AssetPath The Asset path to check
+	* \return True if at least one rule can be applied
+	*/
+	bool RuleCanBeApplied(const FString& AssetPath);
+
+	/**
+	 * \brief Check the rules for many packages at once, only using the Asset Registry so nothing gets loaded.
+	 * The dependencies are fetched on the calling thread, the rules are then evaluated on all worker threads.
+	 * \param PackageNames The packages to check
+	 * \param OutValidationErrors The Error Text per package violating a rule
+	 * \return True if at least one rule was violated
+	 */
+	bool ValidatePackages(const TArray<FName>& PackageNames, TMap<FName, FString>& OutValidationErrors);
+
+	/**
+	 * \brief Check the rules for many packages at once and collect every violation, ordered by package
+	 * \param PackageNames The packages to check
+	 * \param OutViolations The violations to add to
+	 * \param Scope Which checks to run
+	 * \return True if at least one rule was violated
+	 */
+	bool ValidatePackages(const TArray<FName>& PackageNames, FOWIReferenceViolations& OutViolations, EOWIReferenceCheckScope Scope = EOWIReferenceCheckScope::All);
+
+	/**
+	 * \brief Check the rules for every package within a folder, only using the Asset Registry so nothing gets loaded
+	 * \param RootPath The folder to check recursively, e.g. "/Game"
+	 * \param OutValidationErrors The Error Text per package violating a rule
+	 * \return True if at least one rule was violated
+	 */
+	bool ValidatePath(const FString& RootPath, TMap<FName, FString>& OutValidationErrors);
+
+	/**
+	* \brief Forget everything cached about the dependency graph
+	*/
+	void ResetCaches();
+
+	/**
+	 * \brief Get the settings the violations refer to, e.g. to display them
+	 * \return The settings
+	 */
+	const UOWIReferenceRulesHandlerSettings* GetSettings();
+
+	/**
+	 * \brief Drop the checks that are disabled in the settings
+	 * \param Scope The checks to run
+	 * \return The checks that are enabled, None if there is nothing to check
+	 */
+	EOWIReferenceCheckScope GetEnabledScope(EOWIReferenceCheckScope Scope);
+
+private:
+
+	// All available Settings
+	UPROPERTY()
+	UOWIReferenceRulesHandlerSettings* Settings = nullptr;
+
+	// Strongly connected components of the hard dependencies explored so far
+	FOWICircularDependencyDetector CircularDependencyDetector;
+
+	// Forbidden folders reachable from the packages explored so far
+	FOWIReachabilityIndex ReachabilityIndex;
+
+	/**
+	 * \brief Load the settings if not done yet
+	 * \return True if the settings are available
+	 */
+	bool LoadSettings();
+
+	/**
+	 * \brief Get the hard and soft dependencies of a package from the dependency graph, at most a single Asset Registry query
+	 * \param PackageName The package to get the dependencies for
+	 * \param AssetRegistry The Asset Registry to use
+	 * \param OutDependencies The dependencies of the package
+	 */
+	static void GatherDependencies(const FName PackageName, const IAssetRegistry& AssetRegistry, FOWIPackageDependencies& OutDependencies);
+
+	/**
+	 * \brief Check all rules against the already gathered dependencies of a package
+	 * \param AssetPath The path of the Asset to check
+	 * \param Dependencies The dependencies of the package
+	 * \param AssetRegistry The Asset Registry to use for circular dependencies
+	 * \param Scope Which checks to run
+	 * \param OutViolations The violations to add to
+	 * \return True if there are violations
+	 */
+	bool CheckPackage(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, EOWIReferenceCheckScope Scope, FOWIReferenceViolations& OutViolations);
+
+	/**
+	 * \brief Check the rules and the BlackList against the dependencies, only reads so it is safe to call from worker threads
+	 * \param AssetPath The path of the Asset to check
+	 * \param Dependencies The dependencies of the package
+	 * \param OutViolations The violations to add to
+	 * \return True if there are violations
+	 */
+	bool CheckRules(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, FOWIReferenceViolations& OutViolations) const;
+	
+	/**
+	 * \brief Checks all rules
+	 * \param PackageName The package of the Asset to check
+	 * \param AssetContext The compiled rules classification of the Asset
+	 * \param References The references to check
+	 * \param OutViolations The violations to add to
+	 * \return True if there are violations
+	 */
+	bool CheckAllRules(const FName PackageName, const FOWIReferenceRulesAssetContext& AssetContext, const TArray<FName>& References, FOWIReferenceViolations& OutViolations) const;
+
+	/**
+	 * \brief Is any of the references blacklisted?
+	 * \param PackageName The package of the Asset to check
+	 * \param AssetContext The compiled rules classification of the Asset
+	 * \param References The references to check
+	 * \param OutViolations The violations to add to
+	 * \return True if any of the given references is blacklisted
+	 */
+	bool IsBlackListed(const FName PackageName, const FOWIReferenceRulesAssetContext& AssetContext, const TArray<FName>& References, FOWIReferenceViolations& OutViolations) const;
+
+	/**
+	 * \brief Is any of the references a circular reference?
+	 * \param Dependencies The already gathered dependencies of the package
+	 * \param AssetRegistry The Asset Registry to use for the dependencies of other packages
+	 * \param OutViolations The violations to add to
+	 * \return True if any of the given references is circular
+	 */
+	bool HasCircularDependency(const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, FOWIReferenceViolations& OutViolations);
+
+	/**
+	 * \brief Does any dependency reach a forbidden folder through other packages?
+	 * Forbidden folders referenced directly are left to CheckRules, only one chain is reported per rule and BlackList entry.
+	 * \param AssetPath The path of the Asset to check
+	 * \param Dependencies The already gathered dependencies of the package
+	 * \param AssetRegistry The Asset Registry to use for the dependencies of other packages
+	 * \param OutViolations The violations to add to
+	 * \return True if a forbidden folder is reached
+	 */
+	bool HasTransitiveViolation(const FString& AssetPath, const FOWIPackageDependencies& Dependencies, const IAssetRegistry& AssetRegistry, FOWIReferenceViolations& OutViolations);
+};
@@ -0,0 +1,116 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_PathTrie.h"
+
+struct FOWIReferenceRule;
+struct FDirectoryPath;
+
+/** What the compiled rules know about the Asset whose references are being checked */
+struct OWI_EDITORENHANCEMENTS_API FOWIReferenceRulesAssetContext
+{
+	// Rules whose AssetFolder contains the Asset while the Asset isn't inside their MayNotReferenceFolder
+	TBitArray<> ApplicableRules;
+
+	// BlackList entries the Asset is inside of itself
+	TBitArray<> ContainingBlackListEntries;
+};
+
+/**
+ * The ReferenceRules, their ExceptionFolders and the BlackList compiled into a single path trie,
+ * so each reference is classified in one walk without building any strings.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIReferenceRulesMatcher
+{
+
+public:
+
+	/**
+	 * \brief Rebuild the trie from the given configuration
+	 * \param Rules The reference rules to compile
+	 * \param BlackList The blacklisted folders to compile
+	 */
+	void Compile(const TArray<FOWIReferenceRule>& Rules, const TArray<FDirectoryPath>& BlackList);
+
+	/**
+	 * \brief Is the Asset inside the AssetFolder of any rule?
+	 * \param AssetPath The Asset path to check
+	 * \return True if at least one rule can be applied
+	 */
+	bool CanBeApplied(const FString& AssetPath) const;
+
+	/**
+	 * \brief Collect which rules and BlackList entries apply to the Asset
+	 * \param AssetPath The Asset path to check
+	 * \param OutContext The context to pass on to the reference checks
+	 */
+	void ClassifyAsset(const FString& AssetPath, FOWIReferenceRulesAssetContext& OutContext) const;
+
+	/**
+	 * \brief Find the first rule the Reference violates
+	 * \param Context The context of the referencing Asset
+	 * \param Reference The reference to check
+	 * \return The index of the violated rule or INDEX_NONE
+	 */
+	int32 FindViolatedRule(const FOWIReferenceRulesAssetContext& Context, const FName Reference) const;
+
+	/**
+	 * \brief Find the first BlackList entry the Reference is in
+	 * \param Context The context of the referencing Asset
+	 * \param Reference The reference to check
+	 * \return The index of the BlackList entry or INDEX_NONE
+	 */
+	int32 FindBlackListEntry(const FOWIReferenceRulesAssetContext& Context, const FName Reference) const;
+
+	/**
+	 * \brief Collect every rule and BlackList entry the Reference is forbidden by, no matter which Asset references it
+	 * \param Reference The reference to check
+	 * \param OutForbiddenBits A bit per rule followed by a bit per BlackList entry, sized by the caller
+	 */
+	void ClassifyReference(const FName Reference, TBitArray<>& OutForbiddenBits) const;
+
+	int32 GetNumRules() const
+	{
+		return NumRules;
+	}
+
+	int32 GetNumBlackListEntries() const
+	{
+		return NumBlackListEntries;
+	}
+
+private:
+
+	enum class ETagType : int32
+	{
+		AssetFolder,
+		MayNotReferenceFolder,
+		ExceptionFolder,
+		BlackList,
+
+		Num
+	};
+
+	static int32 MakeTag(const ETagType Type, const int32 Index)
+	{
+		return Index * static_cast<int32>(ETagType::Num) + static_cast<int32>(Type);
+	}
+
+	static ETagType GetTagType(const int32 Tag)
+	{
+		return static_cast<ETagType>(Tag % static_cast<int32>(ETagType::Num));
+	}
+
+	static int32 GetTagIndex(const int32 Tag)
+	{
+		return Tag / static_cast<int32>(ETagType::Num);
+	}
+
+	FOWIPathTrie Trie;
+
+	int32 NumRules = 0;
+
+	int32 NumBlackListEntries = 0;
+};
@@ -0,0 +1,106 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The strongly connected components of a dependency graph, shared by FOWICircularDependencyDetector and
+ * FOWIReachabilityIndex. The graph is explored lazily starting at the queried packages with an iterative Tarjan and
+ * every package is only visited once, until Reset is called. Components are finished in reverse topological order, so
+ * when a component is finished every component it depends on is finished already.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIStronglyConnectedComponents
+{
+
+public:
+
+	// Fills the dependencies of the given package that should be part of the graph
+	typedef TFunctionRef<void(FName PackageName, TArray<FName>& OutDependencies)> FGetDependencies;
+
+	// Called once for every newly reached node, after its dependencies are known
+	typedef TFunctionRef<void(int32 Node)> FOnVisit;
+
+	// Called once for every component as soon as all of its members are known
+	typedef TFunctionRef<void(int32 Component, const TArray<int32>& Members)> FOnComponent;
+
+	/**
+	 * \brief Forget the explored graph, e.g. because dependencies changed
+	 */
+	void Reset();
+
+	/**
+	 * \brief Get the node of a package, adding it if it wasn't reached yet
+	 * \param PackageName The package to look up
+	 * \return The node of the package
+	 */
+	int32 FindOrAddNode(FName PackageName);
+
+	/**
+	 * \brief Get the node of a package without adding it
+	 * \param PackageName The package to look up
+	 * \return The node or INDEX_NONE if the package wasn't reached yet
+	 */
+	int32 FindNode(FName PackageName) const;
+
+	/**
+	 * \brief Assign a component to every node reachable from the start node, does nothing if it already has one
+	 * \param StartNode The node to start at
+	 * \param GetDependencies Provides the dependencies of newly reached nodes
+	 * \param OnVisit Called for every newly reached node
+	 * \param OnComponent Called for every newly finished component
+	 */
+	void Explore(int32 StartNode, FGetDependencies GetDependencies, FOnVisit OnVisit, FOnComponent OnComponent);
+
+	FName GetPackageName(const int32 Node) const
+	{
+		return Nodes[Node].PackageName;
+	}
+
+	// The nodes the node depends on, without itself and without duplicates
+	const TArray<int32>& GetDependencies(const int32 Node) const
+	{
+		return Nodes[Node].Dependencies;
+	}
+
+	// The component of the node or INDEX_NONE if it wasn't explored yet
+	int32 GetComponent(const int32 Node) const
+	{
+		return Nodes[Node].Component;
+	}
+
+	/**
+	 * \brief How many packages have been reached so far?
+	 * \return The number of nodes in the graph
+	 */
+	int32 Num() const;
+
+	int32 NumComponents() const;
+
+private:
+
+	struct FNode
+	{
+		FName PackageName;
+
+		TArray<int32> Dependencies;
+
+		int32 Index = INDEX_NONE;
+
+		int32 LowLink = INDEX_NONE;
+
+		int32 Component = INDEX_NONE;
+
+		bool bOnStack = false;
+	};
+
+	TArray<FNode> Nodes;
+
+	TMap<FName, int32> NodeIndices;
+
+	int32 NextComponent = 0;
+
+	int32 NextIndex = 0;
+
+	void Visit(int32 Node, FGetDependencies GetDependencies, FOnVisit OnVisit, TArray<int32>& Stack);
+};
@@ -1,109 +1,170 @@
-// Copyright Offworld Industries
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Misc/Paths.h"
-#include "Engine/DeveloperSettings.h"
-#include "Engine/EngineTypes.h"
-#include "UObject/NoExportTypes.h"
-#include "OWI_UnReleasedAssetsHandler.generated.h"
-
-class UOWIReferenceRulesHandlerSettings;
-class UProjectPackagingSettings;
-
-DECLARE_LOG_CATEGORY_EXTERN(LogUnReleasedAssetHandler, Log, All);
-
-enum EPathState
-{
-	None,
-    Released,
-    Unreleased,
-    Mixed
-};
-
-/**
-* Class to configure the UOWIUnReleasedAssetsHandler
-*/
-UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI UnReleased Assets"))
-class OWI_EDITORENHANCEMENTS_API UOWIUnReleasedAssetsHandlerSettings final : public UDeveloperSettings
-{
-	GENERATED_BODY()
-
-public:
-	
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
-	FLinearColor UnreleasedFolderColor = FLinearColor::Red;
-	
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
-	FLinearColor MixedFolderColor = FLinearColor::Yellow;
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (ContentDir))
-	FDirectoryPath AssetFolderToNotBeReferenced = {"/Game" };
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (FilePath, FilePathFilter="sh"))
-	FFilePath ModSDKFile = { FPaths::ProjectDir().Append("Tools/ModSDK/create_file_list.sh") };
-
-	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
-	FString ModSDKBlacklistStringStart = { "declare -a blacklist=(" };
-
-	UPROPERTY(VisibleAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (DisplayName="Unreleased Folders (read-only)"))
-	TArray<FString> UnreleasedFolders;
-
-	UPROPERTY(Config)
-	TArray<FString> ReleasedFolders;
-
-	UPROPERTY(Config)
-	TArray<FString> MixedFolders;
-};
-
-UCLASS()
-class OWI_EDITORENHANCEMENTS_API UOWIUnReleasedAssetsHandler final : public UObject
-{
-	GENERATED_BODY()
-
-public:
-
-	void ReleaseFolder(FString FolderPath);
-
-	void UnreleaseFolder(FString FolderPath);
-
-	void UpdateFolderColorsOnStart();
-
-	EPathState GetFolderState(TArray<FString> Folders);
-	
-private:
-
-	UPROPERTY()
-	UOWIUnReleasedAssetsHandlerSettings* Settings = nullptr;
-
-	UPROPERTY()
-	UProjectPackagingSettings* PackagingSettings = nullptr;
-
-	UPROPERTY()
-	UOWIReferenceRulesHandlerSettings* ReferenceRulesSettings = nullptr;
-
-	bool LoadSettings();
-
-	void SaveSettings() const;
-	
-	void AddFolderToModSDKBlacklist(FString FolderPath) const;
-
-	void RemoveFolderFromModSDKBlacklist(FString FolderPath) const;
-
-	bool LoadModSDKFile(FString& Content) const;
-
-	void SaveModSDKFile(FString Content) const;
-
-	static FString GetModSDKCompatibleFolderName(FString FolderPath);
-
-	void UpdateInternalConfig(FString FolderPath, EPathState NewPathState) const;
-
-	void UpdateColor(FString FolderPath, EPathState PathState) const;
-
-	void HandleSubfolderRelease(FString CurrentFolderPath, FString ReleaseFolderPath);
-
-	void UpdateParentFolder(FString FolderPath, const bool bRelease);
-
-	static TArray<FString> GetSubfolders(FString FolderPath);
-};
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Paths.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/NoExportTypes.h"
+#include "OWI_FolderStateTree.h"
+#include "OWI_ModSDKBlacklist.h"
+#include "OWI_UnReleasedAssetsHandler.generated.h"
+
+class UOWIReferenceRulesHandlerSettings;
+class UProjectPackagingSettings;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogUnReleasedAssetHandler, Log, All);
+
+/**
+* Class to configure the UOWIUnReleasedAssetsHandler
+*/
+UCLASS(Config = Editor, defaultconfig, meta = (DisplayName = "OWI UnReleased Assets"))
+class OWI_EDITORENHANCEMENTS_API UOWIUnReleasedAssetsHandlerSettings final : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
+	FLinearColor UnreleasedFolderColor = FLinearColor::Red;
+	
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
+	FLinearColor MixedFolderColor = FLinearColor::Yellow;
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (ContentDir))
+	FDirectoryPath AssetFolderToNotBeReferenced = {"/Game" };
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (FilePath, FilePathFilter="sh"))
+	FFilePath ModSDKFile = { FPaths::ProjectDir().Append("Tools/ModSDK/create_file_list.sh") };
+
+	UPROPERTY(EditAnywhere, Config, NoClear, Category = "OWI UnReleased Assets")
+	FString ModSDKBlacklistStringStart = { "declare -a blacklist=(" };
+
+	UPROPERTY(VisibleAnywhere, Config, NoClear, Category = "OWI UnReleased Assets", Meta = (DisplayName="Unreleased Folders (read-only)"))
+	TArray<FString> UnreleasedFolders;
+
+	UPROPERTY(Config)
+	TArray<FString> ReleasedFolders;
+
+	UPROPERTY(Config)
+	TArray<FString> MixedFolders;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+
+	/**
+	 * \brief Get the folder arrays as a tree, building it on first use. Changes are only written back by ApplyFolderStates
+	 * \return The folder states
+	 */
+	FOWIFolderStateTree& GetFolderStates();
+
+	/**
+	 * \brief Write the folder state tree back into the config arrays, needs to be called before saving the config
+	 */
+	void ApplyFolderStates();
+
+	/**
+	 * \brief Make sure the tree is built from the config arrays again, needs to be called after changing them from code
+	 */
+	void InvalidateFolderStates();
+
+private:
+
+	// The folder arrays as a tree, built on first use
+	FOWIFolderStateTree FolderStates;
+
+	bool bFolderStatesBuilt = false;
+};
+
+UCLASS()
+class OWI_EDITORENHANCEMENTS_API UOWIUnReleasedAssetsHandler final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	void ReleaseFolder(FString FolderPath);
+
+	void UnreleaseFolder(FString FolderPath);
+
+	/**
+	 * \brief Release all folders at once, the settings and the ModSDK file are only written once at the end
+	 * \param FolderPaths The folders to release
+	 */
+	void ReleaseFolders(const TArray<FString>& FolderPaths);
+
+	/**
+	 * \brief Unrelease all folders at once, the settings and the ModSDK file are only written once at the end
+	 * \param FolderPaths The folders to unrelease
+	 */
+	void UnreleaseFolders(const TArray<FString>& FolderPaths);
+
+	/**
+	 * \brief Apply the colors of all tracked folders to the per project editor config in one go,
+	 * skipped if they were applied before and neither the folders nor the colors changed since
+	 */
+	void UpdateFolderColorsOnStart();
+
+	EPathState GetFolderState(TArray<FString> Folders);
+	
+private:
+
+	UPROPERTY()
+	UOWIUnReleasedAssetsHandlerSettings* Settings = nullptr;
+
+	UPROPERTY()
+	UProjectPackagingSettings* PackagingSettings = nullptr;
+
+	UPROPERTY()
+	UOWIReferenceRulesHandlerSettings* ReferenceRulesSettings = nullptr;
+
+	// The blacklist of the ModSDK file while a batch of changes is applied, only written once the batch is done
+	FOWIModSDKBlacklist ModSDKBlacklist;
+
+	bool bModSDKBlacklistLoaded = false;
+
+	bool bModSDKBlacklistValid = false;
+
+	bool LoadSettings();
+
+	void SaveSettings() const;
+
+	/**
+	 * \brief Start a batch of changes, all of them are only applied in memory until EndChanges
+	 * \return False if the settings could not be read
+	 */
+	bool BeginChanges();
+
+	/**
+	 * \brief Write the changed ModSDK file and all settings
+	 */
+	void EndChanges();
+
+	void ApplyRelease(const FString& FolderPath);
+
+	void ApplyUnrelease(const FString& FolderPath);
+	
+	void AddFolderToModSDKBlacklist(FString FolderPath);
+
+	void RemoveFolderFromModSDKBlacklist(FString FolderPath);
+
+	bool LoadModSDKBlacklist();
+
+	void SaveModSDKBlacklist();
+
+	static FString GetModSDKCompatibleFolderName(FString FolderPath);
+
+	void UpdateInternalConfig(FString FolderPath, EPathState NewPathState) const;
+
+	void UpdateColor(FString FolderPath, EPathState PathState) const;
+
+	void HandleSubfolderRelease(FString CurrentFolderPath, FString ReleaseFolderPath);
+
+	void UpdateParentFolder(FString FolderPath, const bool bRelease);
+
+	static TArray<FString> GetSubfolders(FString FolderPath);
+};
@@ -0,0 +1,93 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OWI_ValidationCache.h"
+#include "OWI_ValidateCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOWIValidateCommandlet, Log, All);
+
+class UOWIReferenceRulesHandler;
+class UOWINamingConventionHandler;
+
+/** A single failed check as written to the result files */
+struct FOWIValidateCommandletViolation
+{
+	FName PackageName;
+
+	FString Message;
+};
+
+/** The results of one type of check as written to the result files */
+struct FOWIValidateCommandletResult
+{
+	FString CheckName;
+
+	double Seconds = 0.0;
+
+	TArray<FName> CheckedPackages;
+
+	TArray<FOWIValidateCommandletViolation> Violations;
+};
+
+/**
+ * Headless validation of reference rules and naming conventions, e.g. for build agents:
+ * UE4Editor-Cmd.exe Project.uproject -run=OWIValidate -Roots=/Game/Foo+/Game/Bar -Json=Results.json -JUnit=Results.xml
+ * Optional switches: -SkipReferenceRules -SkipNamingConventions -Incremental
+ * With -Incremental only packages that changed since the last run are checked, the others reuse the cached results.
+ * Returns 1 if any violation was found, 0 otherwise.
+ */
+UCLASS()
+class OWI_EDITORENHANCEMENTS_API UOWIValidateCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWIValidateCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+
+	UPROPERTY()
+	UOWIReferenceRulesHandler* ReferenceRulesHandler = nullptr;
+
+	UPROPERTY()
+	UOWINamingConventionHandler* NamingConventionHandler = nullptr;
+
+	FOWIValidationCache ValidationCache;
+
+	bool bIncremental = false;
+
+	/**
+	 * \brief Look up the cached result of an unchanged package
+	 * \param PackageName The package to look up
+	 * \param Check The type of check
+	 * \param OutResult The result to add the cached violation to
+	 * \return True if the package does not need to be checked again
+	 */
+	bool AddCachedResult(FName PackageName, EOWIValidationCheck Check, FOWIValidateCommandletResult& OutResult) const;
+
+	/**
+	 * \brief Check the reference rules for all packages within the roots without loading them
+	 * \param Roots The folders to check
+	 * \param OutResult The result to fill
+	 */
+	void ValidateReferenceRules(const TArray<FString>& Roots, FOWIValidateCommandletResult& OutResult);
+
+	/**
+	 * \brief Check the naming conventions for all Assets within the roots
+	 * \param Roots The folders to check
+	 * \param OutResult The result to fill
+	 */
+	void ValidateNamingConventions(const TArray<FString>& Roots, FOWIValidateCommandletResult& OutResult);
+
+	static bool WriteJson(const FString& FilePath, const TArray<FString>& Roots, const TArray<FOWIValidateCommandletResult>& Results);
+
+	static bool WriteJUnit(const FString& FilePath, const TArray<FOWIValidateCommandletResult>& Results);
+};
@@ -0,0 +1,109 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWI_PackageChangeListener.h"
+
+
+/** The types of checks whose results are cached */
+enum class EOWIValidationCheck : uint8
+{
+	ReferenceRules,
+	NamingConventions,
+
+	Num
+};
+
+/**
+ * Validation results per package, persisted in the Saved folder between sessions.
+ * A result is only valid for the exact saved state of the package (its package guid) and the settings it
+ * was computed with. Asset Registry events drop the results of changed packages and their direct referencers.
+ * Only results that depend on the package alone belong here, circular and transitive dependencies and the naming
+ * conventions of materials and Blueprints are never cached.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIValidationCache
+{
+
+public:
+
+	/**
+	 * \brief Load the persisted results and start listening to Asset Registry changes
+	 */
+	void Initialize();
+
+	/**
+	 * \brief Stop listening to Asset Registry changes and persist the results
+	 */
+	void Shutdown();
+
+	/**
+	 * \brief Hash the current settings, results computed with other settings are ignored from now on
+	 */
+	void UpdateSettingsHash();
+
+	/**
+	 * \brief Get a cached result
+	 * \param PackageName The package to look up
+	 * \param PackageGuid The guid of the saved package the result has to belong to
+	 * \param Check The type of check
+	 * \param OutValidationError The cached Error Text, empty if the check passed
+	 * \return True if a matching result is cached
+	 */
+	bool Find(FName PackageName, const FGuid& PackageGuid, EOWIValidationCheck Check, FString& OutValidationError) const;
+
+	/**
+	 * \brief Cache a result
+	 * \param PackageName The checked package
+	 * \param PackageGuid The guid of the saved package that was checked
+	 * \param Check The type of check
+	 * \param ValidationError The Error Text, empty if the check passed
+	 */
+	void Add(FName PackageName, const FGuid& PackageGuid, EOWIValidationCheck Check, const FString& ValidationError);
+
+	/**
+	 * \brief Drop the results of a package and the packages directly referencing it
+	 * \param PackageName The package that changed
+	 */
+	void Invalidate(FName PackageName);
+
+	/**
+	 * \brief Does the result of the check only depend on the package of the Asset itself?
+	 * The naming conventions of materials depend on their base material and the ones of Blueprints on their parent
+	 * classes, all of which may live in other packages, so these are never cached.
+	 * \param AssetClass The class of the checked Asset
+	 * \param Check The type of check
+	 * \return True if the result may be cached
+	 */
+	static bool IsCacheable(const UClass* AssetClass, EOWIValidationCheck Check);
+
+	bool Load();
+
+	bool Save() const;
+
+private:
+
+	struct FEntry
+	{
+		FGuid PackageGuid;
+
+		uint32 SettingsHash = 0;
+
+		// Which checks have a result
+		uint8 CheckedMask = 0;
+
+		FString ValidationErrors[static_cast<int32>(EOWIValidationCheck::Num)];
+	};
+
+	TMap<FName, FEntry> Entries;
+
+	uint32 SettingsHash = 0;
+
+	bool bDirty = false;
+
+	FOWIPackageChangeListener PackageChangeListener;
+
+	static FString GetCacheFilePath();
+
+	static uint32 ComputeSettingsHash();
+};
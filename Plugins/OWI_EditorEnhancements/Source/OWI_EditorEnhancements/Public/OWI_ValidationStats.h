@@ -0,0 +1,110 @@
+// Copyright Offworld Industries
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOWIValidation, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("OWI Validation"), STATGROUP_OWIValidation, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate Asset"), STAT_OWI_ValidateAsset, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather Dependencies"), STAT_OWI_GatherDependencies, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reference Rules"), STAT_OWI_ReferenceRules, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Circular Dependencies"), STAT_OWI_CircularDependencies, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transitive References"), STAT_OWI_TransitiveReferences, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Naming Conventions"), STAT_OWI_NamingConventions, STATGROUP_OWIValidation, OWI_EDITORENHANCEMENTS_API);
+
+/** The timed sections of a validation */
+enum class EOWIValidationTimer : uint8
+{
+	ValidateAsset,
+	GatherDependencies,
+	ReferenceRules,
+	CircularDependencies,
+	TransitiveReferences,
+	NamingConventions,
+
+	Num
+};
+
+/** The counted events of a validation */
+enum class EOWIValidationCounter : uint8
+{
+	ReferenceRulesChecked,
+	NamingConventionsChecked,
+	RegistryQueries,
+	RulesEvaluated,
+	ValidationCacheHits,
+	ValidationCacheMisses,
+	ClassCacheHits,
+	DependencyGraphHits,
+	Violations,
+
+	Num
+};
+
+/**
+ * Timings and counters of the current validation batch, summarized in the log when the batch ends.
+ * Everything is atomic since the reference rules are evaluated on worker threads.
+ */
+class OWI_EDITORENHANCEMENTS_API FOWIValidationStats
+{
+
+public:
+
+	static FOWIValidationStats& Get();
+
+	void Add(EOWIValidationCounter Counter, int64 Value = 1);
+
+	void AddCycles(EOWIValidationTimer Timer, uint64 Cycles);
+
+	/**
+	 * \brief Start counting from zero, e.g. at the start of a validation batch
+	 */
+	void Reset();
+
+	/**
+	 * \brief Log all timings and counters since the last reset, nothing is logged if no Asset was checked
+	 * \param BatchName Describes what was validated
+	 */
+	void LogSummary(const TCHAR* BatchName) const;
+
+	/** Adds the time of its scope to one of the timers */
+	class FScopedTimer
+	{
+
+	public:
+
+		explicit FScopedTimer(const EOWIValidationTimer InTimer)
+			: Timer(InTimer)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		~FScopedTimer()
+		{
+			Get().AddCycles(Timer, FPlatformTime::Cycles64() - StartCycles);
+		}
+
+	private:
+
+		EOWIValidationTimer Timer;
+
+		uint64 StartCycles;
+	};
+
+private:
+
+	TAtomic<int64> Counters[static_cast<int32>(EOWIValidationCounter::Num)];
+
+	TAtomic<uint64> Cycles[static_cast<int32>(EOWIValidationTimer::Num)];
+};
+
+// Times the scope for Unreal Insights, the stats system and the batch summary at once
+#define OWI_VALIDATION_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(OWI_##Name); \
+	SCOPE_CYCLE_COUNTER(STAT_OWI_##Name); \
+	const FOWIValidationStats::FScopedTimer OWIValidationTimer_##Name(EOWIValidationTimer::Name)